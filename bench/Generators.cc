@@ -0,0 +1,217 @@
+/***********************************************************************************[Generators.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "bench/Generators.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Cnf:
+
+void Cnf::addClause(Lit p)
+{
+    clauses.push();
+    clauses.last().push(p);
+}
+void Cnf::addClause(Lit p, Lit q)
+{
+    clauses.push();
+    clauses.last().push(p);
+    clauses.last().push(q);
+}
+void Cnf::addClause(Lit p, Lit q, Lit r)
+{
+    clauses.push();
+    clauses.last().push(p);
+    clauses.last().push(q);
+    clauses.last().push(r);
+}
+
+void Cnf::addXor(Lit x, Lit a, Lit b)
+{
+    addClause(~x, a, b);
+    addClause(~x, ~a, ~b);
+    addClause(x, ~a, b);
+    addClause(x, a, ~b);
+}
+
+void Cnf::addAnd(Lit x, Lit a, Lit b)
+{
+    addClause(~x, a);
+    addClause(~x, b);
+    addClause(x, ~a, ~b);
+}
+
+void Cnf::toDimacs(FILE* f) const
+{
+    fprintf(f, "p cnf %d %d\n", nvars, clauses.size());
+    for (int i = 0; i < clauses.size(); i++) {
+        for (int j = 0; j < clauses[i].size(); j++)
+            fprintf(f, "%s%d ", sign(clauses[i][j]) ? "-" : "", var(clauses[i][j]) + 1);
+        fprintf(f, "0\n");
+    }
+}
+
+//=================================================================================================
+// Generators:
+
+// The random number generator of 'Solver' (the seed must never be 0):
+static double drand(double& seed)
+{
+    seed *= 1389796;
+    int q = (int)(seed / 2147483647);
+    seed -= (double)q * 2147483647;
+    return seed / 2147483647;
+}
+static int irand(double& seed, int size)
+{
+    return (int)(drand(seed) * size);
+}
+
+double Minisat::kSatThreshold(int k)
+{
+    static const double known[] = {0, 1, 1, 4.267, 9.931, 21.117, 43.37, 87.79};
+    if (k < 8)
+        return known[k];
+    double t = 0.69314718056; // (2^k ln 2 asymptotically)
+    for (int i = 0; i < k; i++)
+        t *= 2;
+    return t;
+}
+
+void Minisat::genRandomKSat(Cnf& f, int n, int k, double ratio, double seed)
+{
+    for (int i = 0; i < n; i++)
+        f.newVar();
+    int m = (int)(ratio * n + 0.5);
+    vec<Lit> ps;
+    for (int i = 0; i < m; i++) {
+        ps.clear();
+        while (ps.size() < k) {
+            Var v = irand(seed, n);
+            bool dup = false;
+            for (int j = 0; j < ps.size() && !dup; j++)
+                dup = var(ps[j]) == v;
+            if (!dup)
+                ps.push(mkLit(v, drand(seed) < 0.5));
+        }
+        f.addClause(ps);
+    }
+}
+
+void Minisat::genPigeonhole(Cnf& f, int holes)
+{
+    int pigeons = holes + 1;
+    Var base = f.nvars;
+    for (int i = 0; i < pigeons * holes; i++)
+        f.newVar();
+
+    // (pigeon 'p' is in hole 'h' if variable 'base + p * holes + h' is true)
+    vec<Lit> ps;
+    for (int p = 0; p < pigeons; p++) {
+        ps.clear();
+        for (int h = 0; h < holes; h++)
+            ps.push(mkLit(base + p * holes + h));
+        f.addClause(ps);
+    }
+    for (int h = 0; h < holes; h++)
+        for (int p = 0; p < pigeons; p++)
+            for (int q = p + 1; q < pigeons; q++)
+                f.addClause(~mkLit(base + p * holes + h), ~mkLit(base + q * holes + h));
+}
+
+void Minisat::genParity(Cnf& f, int n, double seed)
+{
+    vec<Var> xs, perm;
+    for (int i = 0; i < n; i++)
+        xs.push(f.newVar());
+    xs.copyTo(perm);
+    for (int i = n - 1; i > 0; i--) {
+        int j = irand(seed, i + 1);
+        Var tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+
+    Lit a = mkLit(xs[0]), b = mkLit(perm[0]);
+    for (int i = 1; i < n; i++) {
+        Lit na = mkLit(f.newVar()), nb = mkLit(f.newVar());
+        f.addXor(na, a, mkLit(xs[i]));
+        f.addXor(nb, b, mkLit(perm[i]));
+        a = na, b = nb;
+    }
+    f.addClause(a, b);
+    f.addClause(~a, ~b);
+}
+
+void Minisat::genColoring(Cnf& f, int n, int colors, double degree, double seed)
+{
+    Var base = f.nvars;
+    for (int i = 0; i < n * colors; i++)
+        f.newVar();
+
+    // (vertex 'v' has color 'c' if variable 'base + v * colors + c' is true)
+    vec<Lit> ps;
+    for (int v = 0; v < n; v++) {
+        ps.clear();
+        for (int c = 0; c < colors; c++)
+            ps.push(mkLit(base + v * colors + c));
+        f.addClause(ps);
+        for (int c = 0; c < colors; c++)
+            for (int d = c + 1; d < colors; d++)
+                f.addClause(~mkLit(base + v * colors + c), ~mkLit(base + v * colors + d));
+    }
+
+    int m = (int)(degree * n / 2 + 0.5);
+    for (int i = 0; i < m; i++) {
+        int v = irand(seed, n), w;
+        while ((w = irand(seed, n)) == v)
+            ;
+        for (int c = 0; c < colors; c++)
+            f.addClause(~mkLit(base + v * colors + c), ~mkLit(base + w * colors + c));
+    }
+}
+
+void Minisat::genCounter(Cnf& f, int bits, int steps)
+{
+    vec<Lit> state, next, carry;
+    for (int i = 0; i < bits; i++) {
+        state.push(mkLit(f.newVar()));
+        f.addClause(~state[i]);
+    }
+
+    for (int t = 0; t < steps; t++) {
+        Lit c = mkLit(f.newVar()); // (the input enabling this step)
+        next.clear();
+        for (int i = 0; i < bits; i++) {
+            next.push(mkLit(f.newVar()));
+            f.addXor(next[i], state[i], c);
+            if (i + 1 < bits) {
+                Lit nc = mkLit(f.newVar());
+                f.addAnd(nc, state[i], c);
+                c = nc;
+            }
+        }
+        next.copyTo(state);
+    }
+
+    for (int i = 0; i < bits; i++)
+        f.addClause(state[i]);
+}
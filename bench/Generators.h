@@ -0,0 +1,85 @@
+/************************************************************************************[Generators.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Generators_h
+#define Minisat_Generators_h
+
+#include <stdio.h>
+
+#include "minisat/core/SolverTypes.h"
+#include "minisat/mtl/Vec.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Cnf -- a generated formula, to be loaded into a solver (or written in DIMACS-format):
+
+class Cnf
+{
+   public:
+    int nvars;
+    vec<vec<Lit> > clauses;
+
+    Cnf() : nvars(0)
+    {
+    }
+    Var newVar()
+    {
+        return nvars++;
+    }
+    void addClause(const vec<Lit>& ps)
+    {
+        clauses.push();
+        ps.copyTo(clauses.last());
+    }
+    void addClause(Lit p);
+    void addClause(Lit p, Lit q);
+    void addClause(Lit p, Lit q, Lit r);
+    void addXor(Lit x, Lit a, Lit b); // Clauses for 'x = a XOR b'.
+    void addAnd(Lit x, Lit a, Lit b); // Clauses for 'x = a AND b'.
+
+    void toDimacs(FILE* f) const;
+};
+
+//=================================================================================================
+// Generators: (the same parameters and seed always give the same formula)
+
+// Random k-SAT with 'ratio * n' clauses of 'k' distinct variables (see 'kSatThreshold()').
+void genRandomKSat(Cnf& f, int n, int k, double ratio, double seed);
+double kSatThreshold(int k); // The clause/variable ratio of the satisfiability threshold.
+
+// 'holes + 1' pigeons in 'holes' holes (unsatisfiable).
+void genPigeonhole(Cnf& f, int holes);
+
+// The parity of 'n' variables computed by two XOR chains over different (random) orders, with
+// outputs asserted to differ (unsatisfiable).
+void genParity(Cnf& f, int n, double seed);
+
+// Coloring a random graph of 'n' vertices and average degree 'degree' with 'colors' colors.
+void genColoring(Cnf& f, int n, int colors, double degree, double seed);
+
+// Bounded model checking of a 'bits'-bit counter incremented when a free input is set: can it be
+// all ones after 'steps' steps? (satisfiable iff 'steps >= 2^bits - 1')
+void genCounter(Cnf& f, int bits, int steps);
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
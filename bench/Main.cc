@@ -0,0 +1,336 @@
+/*****************************************************************************************[Main.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_FORK
+#endif
+
+#include "bench/Generators.h"
+#include "minisat/simp/SimpSolver.h"
+#include "minisat/utils/Options.h"
+#include "minisat/utils/System.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// The instances:
+
+enum { rand_ksat, pigeonhole, parity, coloring, counter };
+
+struct Instance {
+    const char* name;
+    int kind;
+    int a, b;    // (the size parameters of the generator)
+    double x;    // (ratio or degree)
+    double seed; // (of the generator)
+};
+
+static const Instance suite[] = {
+    {"rand3-250-1", rand_ksat, 250, 3, 4.267, 1},   {"rand3-250-3", rand_ksat, 250, 3, 4.267, 3},
+    {"rand3-350-1", rand_ksat, 350, 3, 4.267, 4},   {"rand5-70-1", rand_ksat, 70, 5, 21.117, 19},
+    {"php-8", pigeonhole, 8, 0, 0, 0},              {"php-9", pigeonhole, 9, 0, 0, 0},
+    {"parity-24", parity, 24, 0, 0, 6},             {"parity-28", parity, 28, 0, 0, 6},
+    {"color3-400-1", coloring, 400, 3, 4.65, 12},   {"color3-500-1", coloring, 500, 3, 4.6, 11},
+    {"color4-150-1", coloring, 150, 4, 8.7, 13},    {"counter-6-62", counter, 6, 62, 0, 0},
+    {"counter-7-126", counter, 7, 126, 0, 0},       {"counter-7-127", counter, 7, 127, 0, 0},
+};
+static const int suite_size = sizeof(suite) / sizeof(suite[0]);
+
+static void generate(const Instance& in, Cnf& f)
+{
+    switch (in.kind) {
+    case rand_ksat: genRandomKSat(f, in.a, in.b, in.x, in.seed); break;
+    case pigeonhole: genPigeonhole(f, in.a); break;
+    case parity: genParity(f, in.a, in.seed); break;
+    case coloring: genColoring(f, in.a, in.b, in.x, in.seed); break;
+    case counter: genCounter(f, in.a, in.b); break;
+    }
+}
+
+//=================================================================================================
+// Running:
+
+struct Result {
+    char status; // ('S'atisfiable, 'U'nsatisfiable or 'I'ndeterminate)
+    int vars, clauses;
+    double wall, peak_mb;
+    uint64_t conflicts, propagations;
+};
+
+static double rate(double x, double secs)
+{
+    return secs > 0 ? x / secs : 0;
+}
+
+static const char* statusName(char st)
+{
+    return st == 'S' ? "SAT" : st == 'U' ? "UNSAT" : "INDET";
+}
+
+template <class S> static void load(S& s, const Cnf& f)
+{
+    while (s.nVars() < f.nvars)
+        s.newVar();
+    vec<Lit> ps;
+    for (int i = 0; i < f.clauses.size(); i++) {
+        f.clauses[i].copyTo(ps);
+        s.addClause_(ps);
+    }
+}
+
+static void run(const Instance& in, bool simp, Result& r)
+{
+    Cnf f;
+    generate(in, f);
+    r.vars = f.nvars;
+    r.clauses = f.clauses.size();
+
+    double start = realTime();
+    vec<Lit> dummy;
+    lbool ret;
+    Solver* s;
+    if (simp) {
+        SimpSolver* ss = new SimpSolver;
+        load(*ss, f);
+        ret = ss->eliminate(true) ? ss->solveLimited(dummy) : l_False;
+        s = ss;
+    } else {
+        s = new Solver;
+        load(*s, f);
+        ret = s->simplify() ? s->solveLimited(dummy) : l_False;
+    }
+    r.wall = realTime() - start;
+    r.status = ret == l_True ? 'S' : ret == l_False ? 'U' : 'I';
+    r.conflicts = s->conflicts;
+    r.propagations = s->propagations;
+    r.peak_mb = memUsedPeak();
+    delete s;
+}
+
+// Run in a child process where possible, so that the peak memory is that of the instance alone and
+// instances do not share a heap:
+static bool runIsolated(const Instance& in, bool simp, Result& r)
+{
+#ifdef BENCH_FORK
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        run(in, simp, r);
+        bool ok = write(fds[1], &r, sizeof(r)) == (ssize_t)sizeof(r);
+        _exit(ok ? 0 : 1);
+    }
+    close(fds[1]);
+    bool ok = pid > 0 && read(fds[0], &r, sizeof(r)) == (ssize_t)sizeof(r);
+    close(fds[0]);
+    if (pid > 0)
+        waitpid(pid, NULL, 0);
+    return ok;
+#else
+    run(in, simp, r);
+    return true;
+#endif
+}
+
+//=================================================================================================
+// Baselines:
+
+// A minimal reader of the objects written by 'writeResults()': the value of 'key' in the object
+// starting at 'obj' (up to the next '}').
+static bool jsonField(const char* obj, const char* key, char* str, int len, double* num)
+{
+    const char* end = strchr(obj, '}');
+    char pat[64];
+    snprintf(pat, sizeof(pat), "\"%s\": ", key);
+    const char* p = strstr(obj, pat);
+    if (p == NULL || (end != NULL && p > end))
+        return false;
+    p += strlen(pat);
+    if (str != NULL) {
+        if (*p++ != '"')
+            return false;
+        int i = 0;
+        while (*p != '"' && *p != '\0' && i < len - 1)
+            str[i++] = *p++;
+        str[i] = '\0';
+        return true;
+    }
+    return sscanf(p, "%lf", num) == 1;
+}
+
+struct Baseline {
+    char name[64], solver[8], result[8];
+    double wall, props_per_sec;
+};
+
+static bool readBaseline(const char* file, vec<Baseline>& out)
+{
+    FILE* f = fopen(file, "rb");
+    if (f == NULL)
+        return false;
+    vec<char> text;
+    int c;
+    while ((c = fgetc(f)) != EOF)
+        text.push((char)c);
+    text.push('\0');
+    fclose(f);
+
+    for (const char* p = strstr(&text[0], "{\"name\""); p != NULL; p = strstr(p + 1, "{\"name\"")) {
+        Baseline b;
+        if (jsonField(p, "name", b.name, sizeof(b.name), NULL) &&
+            jsonField(p, "solver", b.solver, sizeof(b.solver), NULL) &&
+            jsonField(p, "result", b.result, sizeof(b.result), NULL) &&
+            jsonField(p, "wall", NULL, 0, &b.wall) &&
+            jsonField(p, "props_per_sec", NULL, 0, &b.props_per_sec))
+            out.push(b);
+    }
+    return true;
+}
+
+//=================================================================================================
+// Main:
+
+int main(int argc, char** argv)
+{
+    setUsageHelp(
+        "USAGE: %s [options]\n\n  Runs the generated benchmark suite (or the instances whose "
+        "name contains '-filter').\n");
+    setX86FPUPrecision();
+
+    BoolOption simp("BENCH", "simp", "Use the simplifying solver (with preprocessing).", false);
+    StringOption filter("BENCH", "filter", "Only run the instances whose name contains this.");
+    StringOption out("BENCH", "out", "Write the results as JSON to this file.");
+    StringOption baseline("BENCH", "baseline", "Compare the results to this file (from '-out').");
+    DoubleOption tolerance("BENCH", "tolerance",
+                           "Wall-time slowdown against the baseline reported as a regression "
+                           "(differences below 50 ms are ignored).",
+                           0.10, DoubleRange(0, true, HUGE_VAL, false));
+    StringOption dimacs("BENCH", "dimacs",
+                        "If given, write the instances in DIMACS-format to this directory "
+                        "instead of solving them.");
+    parseOptions(argc, argv, true);
+
+    const char* solver = simp ? "simp" : "core";
+    vec<int> run_ids;
+    vec<Result> results;
+    for (int i = 0; i < suite_size; i++)
+        if (!filter || strstr(suite[i].name, filter) != NULL)
+            run_ids.push(i);
+
+    if (dimacs) {
+        for (int i = 0; i < run_ids.size(); i++) {
+            char file[1024];
+            snprintf(file, sizeof(file), "%s/%s.cnf", (const char*)dimacs, suite[run_ids[i]].name);
+            FILE* f = fopen(file, "wb");
+            if (f == NULL)
+                printf("ERROR! Could not open file: %s\n", file), exit(1);
+            Cnf cnf;
+            generate(suite[run_ids[i]], cnf);
+            cnf.toDimacs(f);
+            fclose(f);
+        }
+        return 0;
+    }
+
+    printf("%-16s %-6s %8s %9s %9s %12s %12s %9s\n", "instance", "result", "vars", "clauses",
+           "wall (s)", "confl/s", "props/s", "peak MB");
+    for (int i = 0; i < run_ids.size(); i++) {
+        const Instance& in = suite[run_ids[i]];
+        Result r;
+        if (!runIsolated(in, simp, r))
+            printf("ERROR! Running instance %s failed.\n", in.name), exit(1);
+        results.push(r);
+        printf("%-16s %-6s %8d %9d %9.3f %12.0f %12.0f %9.2f\n", in.name, statusName(r.status),
+               r.vars, r.clauses, r.wall, rate(r.conflicts, r.wall), rate(r.propagations, r.wall),
+               r.peak_mb);
+    }
+
+    if (out) {
+        FILE* f = fopen(out, "wb");
+        if (f == NULL)
+            printf("ERROR! Could not open file: %s\n", (const char*)out), exit(1);
+        fprintf(f, "{\"instances\": [\n");
+        for (int i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            fprintf(f,
+                    "  {\"name\": \"%s\", \"solver\": \"%s\", \"result\": \"%s\", \"vars\": %d, "
+                    "\"clauses\": %d, \"wall\": %.4f, \"conflicts\": %" PRIu64
+                    ", \"conflicts_per_sec\": %.0f, \"propagations\": %" PRIu64
+                    ", \"props_per_sec\": %.0f, \"peak_mb\": %.2f}%s\n",
+                    suite[run_ids[i]].name, solver, statusName(r.status), r.vars, r.clauses,
+                    r.wall, r.conflicts, rate(r.conflicts, r.wall), r.propagations,
+                    rate(r.propagations, r.wall), r.peak_mb, i + 1 < results.size() ? "," : "");
+        }
+        fprintf(f, "]}\n");
+        fclose(f);
+    }
+
+    int regressions = 0;
+    if (baseline) {
+        vec<Baseline> base;
+        if (!readBaseline(baseline, base))
+            printf("ERROR! Could not open file: %s\n", (const char*)baseline), exit(1);
+
+        printf("\n%-16s %10s %10s %8s %12s  %s\n", "instance", "base (s)", "wall (s)", "ratio",
+               "props ratio", "verdict");
+        double log_sum = 0;
+        int compared = 0;
+        for (int i = 0; i < results.size(); i++) {
+            const char* name = suite[run_ids[i]].name;
+            const Result& r = results[i];
+            int j = 0;
+            while (j < base.size() && (strcmp(base[j].name, name) != 0 ||
+                                       strcmp(base[j].solver, solver) != 0))
+                j++;
+            if (j == base.size()) {
+                printf("%-16s %10s\n", name, "-");
+                continue;
+            }
+
+            double ratio = base[j].wall > 0 ? r.wall / base[j].wall : 1;
+            const char* verdict = "";
+            if (strcmp(base[j].result, statusName(r.status)) != 0)
+                verdict = "MISMATCH", regressions++;
+            else if (fabs(r.wall - base[j].wall) < 0.05)
+                ; // (too short to tell)
+            else if (ratio > 1 + tolerance)
+                verdict = "slower", regressions++;
+            else if (ratio < 1 / (1 + tolerance))
+                verdict = "faster";
+            printf("%-16s %10.3f %10.3f %8.2f %12.2f  %s\n", name, base[j].wall, r.wall, ratio,
+                   rate(rate(r.propagations, r.wall), base[j].props_per_sec), verdict);
+            log_sum += log(ratio);
+            compared++;
+        }
+        if (compared > 0)
+            printf("geometric mean wall ratio: %.3f (%d instances, %d regressions)\n",
+                   exp(log_sum / compared), compared, regressions);
+    }
+
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+/****************************************************************************************[Micro.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "bench/Generators.h"
+#include "minisat/core/Solver.h"
+#include "minisat/mtl/Heap.h"
+#include "minisat/utils/Options.h"
+#include "minisat/utils/System.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Microbenchmarks of the inner loops: each prints the cost of one unit of work.
+
+// Exposes the internals measured:
+class MicroSolver : public Solver
+{
+   public:
+    using Solver::analyze;
+    using Solver::cancelUntil;
+    using Solver::decisionLevel;
+    using Solver::drand;
+    using Solver::irand;
+    using Solver::propagate;
+
+    // Random decisions from level 0 until a conflict or a full assignment:
+    CRef descend(double& seed)
+    {
+        CRef confl = propagate();
+        while (confl == CRef_Undef && nAssigns() < nVars()) {
+            Var v = irand(seed, nVars());
+            while (value(v) != l_Undef)
+                v = v + 1 < nVars() ? v + 1 : 0;
+            newDecisionLevel();
+            uncheckedEnqueue(mkLit(v, drand(seed) < 0.5));
+            confl = propagate();
+        }
+        return confl;
+    }
+};
+
+template <class S> static void load(S& s, const Cnf& f)
+{
+    while (s.nVars() < f.nvars)
+        s.newVar();
+    vec<Lit> ps;
+    for (int i = 0; i < f.clauses.size(); i++) {
+        f.clauses[i].copyTo(ps);
+        s.addClause_(ps);
+    }
+}
+
+static void report(const char* name, double secs, double units, const char* unit)
+{
+    printf("%-22s: %10.1f ns/%-16s (%.0f in %.3f s)\n", name, units > 0 ? secs * 1e9 / units : 0,
+           unit, units, secs);
+}
+
+//=================================================================================================
+// Propagation and conflict analysis:
+
+// 'propagate()' over the clauses of a large random 3-SAT instance, from random decisions:
+static void benchPropagate(int n, int descents, double seed)
+{
+    Cnf f;
+    genRandomKSat(f, n, 3, 4.2, seed);
+    MicroSolver s;
+    load(s, f);
+
+    uint64_t visits = s.watcher_visits, props = s.propagations;
+    double start = realTime();
+    for (int i = 0; i < descents; i++) {
+        s.descend(seed);
+        s.cancelUntil(0);
+    }
+    double secs = Profile::enabled() ? s.prof.seconds(Profile::propagate) : realTime() - start;
+    report("propagate", secs, s.watcher_visits - visits, "watcher visit");
+    report("propagate", secs, s.propagations - props, "propagation");
+}
+
+// 'analyze()' (with minimization) of the conflicts reached by random decisions:
+static void benchAnalyze(int n, int conflicts, double seed)
+{
+    Cnf f;
+    genRandomKSat(f, n, 3, 4.26, seed);
+    MicroSolver s;
+    load(s, f);
+
+    vec<Lit> learnt;
+    int bt, analyzed = 0;
+    double secs = 0;
+    uint64_t max_lits = s.max_literals, tot_lits = s.tot_literals;
+    while (analyzed < conflicts) {
+        CRef confl = s.descend(seed);
+        if (confl != CRef_Undef && s.decisionLevel() > 0) {
+            learnt.clear();
+            double start = realTime();
+            s.analyze(confl, learnt, bt);
+            secs += realTime() - start;
+            analyzed++;
+        }
+        s.cancelUntil(0);
+    }
+    if (Profile::enabled())
+        secs = s.prof.seconds(Profile::analyze);
+    report("analyze", secs, analyzed, "conflict");
+    if (Profile::enabled())
+        report("  (minimization)", s.prof.seconds(Profile::minimize), analyzed, "conflict");
+    max_lits = s.max_literals - max_lits;
+    tot_lits = s.tot_literals - tot_lits;
+    printf("  (%.1f literals per learnt clause, %.1f %% removed by minimization)\n",
+           (double)tot_lits / analyzed,
+           max_lits == 0 ? 0 : (max_lits - tot_lits) * 100.0 / max_lits);
+}
+
+//=================================================================================================
+// Heap:
+
+struct ActLt {
+    const vec<double>& act;
+    bool operator()(int x, int y) const
+    {
+        return act[x] > act[y];
+    }
+    ActLt(const vec<double>& a) : act(a)
+    {
+    }
+};
+
+// As the decision heap: a maximum-heap on activities that only ever grow.
+static void benchHeap(int n, double seed)
+{
+    vec<double> act;
+    for (int i = 0; i < n; i++)
+        act.push(MicroSolver::drand(seed));
+    Heap<int, ActLt> heap((ActLt(act)));
+
+    double start = realTime();
+    for (int i = 0; i < n; i++)
+        heap.insert(i);
+    report("heap insert", realTime() - start, n, "operation");
+
+    start = realTime();
+    for (int i = 0; i < n; i++) {
+        int k = MicroSolver::irand(seed, n);
+        act[k] += MicroSolver::drand(seed);
+        heap.decrease(k);
+    }
+    report("heap decrease", realTime() - start, n, "operation");
+
+    start = realTime();
+    while (!heap.empty())
+        heap.removeMin();
+    report("heap removeMin", realTime() - start, n, "operation");
+}
+
+//=================================================================================================
+// Clause allocation and garbage collection:
+
+static void benchAllocator(int n, double seed)
+{
+    ClauseAllocator ca;
+    vec<CRef> crefs;
+    vec<Lit> ps;
+    double start = realTime();
+    for (int i = 0; i < n; i++) {
+        ps.clear();
+        int size = 3 + MicroSolver::irand(seed, 20);
+        for (int j = 0; j < size; j++)
+            ps.push(mkLit(j));
+        crefs.push(ca.alloc(ps, i & 1));
+    }
+    report("clause alloc", realTime() - start, n, "clause");
+
+    // Free every other clause, then move the rest to a new region (as 'relocAll()' does):
+    int i, j;
+    for (i = j = 0; i < crefs.size(); i++)
+        if (i & 1)
+            ca.free(crefs[i]);
+        else
+            crefs[j++] = crefs[i];
+    crefs.shrink(i - j);
+
+    start = realTime();
+    ClauseAllocator to(ca.size() - ca.wasted());
+    for (i = 0; i < crefs.size(); i++)
+        ca.reloc(crefs[i], to);
+    to.moveTo(ca);
+    report("clause reloc", realTime() - start, crefs.size(), "clause");
+}
+
+// 'garbageCollect()' of a solver with learnt clauses, after some search:
+static void benchGarbageCollect(int n, int conflicts, int rounds, double seed)
+{
+    Cnf f;
+    genRandomKSat(f, n, 3, 4.26, seed);
+    Solver s;
+    load(s, f);
+    s.setConfBudget(conflicts);
+    vec<Lit> dummy;
+    s.solveLimited(dummy);
+
+    double start = realTime();
+    for (int i = 0; i < rounds; i++)
+        s.garbageCollect();
+    double secs = realTime() - start;
+    report("garbageCollect", secs, rounds, "collection");
+    report("garbageCollect", secs, (double)rounds * (s.nClauses() + s.nLearnts()), "clause");
+}
+
+//=================================================================================================
+// Main:
+
+int main(int argc, char** argv)
+{
+    setUsageHelp("USAGE: %s [options]\n\n  Runs the microbenchmarks.\n");
+    setX86FPUPrecision();
+
+    DoubleOption scale("MICRO", "scale", "Multiply the amount of work of each benchmark by this.",
+                       1.0, DoubleRange(0, false, HUGE_VAL, false));
+    IntOption seed("MICRO", "seed", "Seed of the generated instances and operations.", 91648253,
+                   IntRange(1, INT32_MAX));
+    parseOptions(argc, argv, true);
+
+    benchPropagate(100000, (int)(100 * scale), seed);
+    benchAnalyze(400, (int)(20000 * scale), seed);
+    benchHeap((int)(1000000 * scale), seed);
+    benchAllocator((int)(1000000 * scale), seed);
+    benchGarbageCollect(5000, 20000, (int)(100 * scale), seed);
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************[BackboneSolver.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/backbone/BackboneSolver.h"
+#include "minisat/utils/Options.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Options:
+
+static const char* _cat = "BACKBONE";
+
+static IntOption opt_chunk(_cat, "chunk", "The number of candidates checked by one query.", 64,
+                           IntRange(1, INT32_MAX));
+static IntOption opt_chunk_confl(_cat, "chunk-confl",
+                                 "Conflict budget of a query over several candidates (after "
+                                 "which the chunk size is halved).",
+                                 1000, IntRange(0, INT32_MAX));
+static BoolOption opt_probe(_cat, "probe-cands", "Check candidates by unit propagation first.",
+                            true);
+
+//=================================================================================================
+// Constructor/Destructor:
+
+BackboneSolver::BackboneSolver()
+    : verbosity(0),
+      chunk(opt_chunk),
+      chunk_confl(opt_chunk_confl),
+      probe(opt_probe),
+      queries(0),
+      probed(0),
+      filtered(0),
+      interrupted(false)
+{
+}
+
+BackboneSolver::~BackboneSolver()
+{
+}
+
+//=================================================================================================
+// Solving:
+
+void BackboneSolver::collectFixed()
+{
+    int i, j;
+    for (i = j = 0; i < cands.size(); i++)
+        if (solver.value(cands[i]) == l_True)
+            backbone.push(cands[i]);
+        else
+            cands[j++] = cands[i];
+    cands.shrink(i - j);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  compute : (vs : const vec<Var>&)  ->  [lbool]
+|
+|  Description:
+|    Narrow the candidates down until each is either refuted by a model or proved to be in the
+|    backbone. A query over a single candidate just assumes its negation. Queries over several
+|    candidates run under a conflict budget, and the chunk size is halved whenever it runs out
+|    (proving many candidates at once can be much harder than proving them one by one).
+|________________________________________________________________________________________________@*/
+lbool BackboneSolver::compute(const vec<Var>& vs)
+{
+    backbone.clear();
+    cands.clear();
+
+    vec<Lit> as;
+    queries++;
+    lbool ret = solver.solveLimited(as);
+    if (ret != l_True)
+        return ret;
+
+    int n = vs.size() > 0 ? vs.size() : solver.nVars();
+    for (int i = 0; i < n; i++) {
+        Var v = vs.size() > 0 ? vs[i] : i;
+        if (solver.modelValue(v) != l_Undef)
+            cands.push(mkLit(v, solver.modelValue(v) == l_False));
+    }
+
+    // Decide the candidates against their value in the first model (see 'pickBranchLit()'):
+    vec<Var> biased;
+    for (int i = 0; i < cands.size(); i++) {
+        solver.setPolarity(var(cands[i]), lbool(!sign(cands[i])));
+        biased.push(var(cands[i]));
+    }
+
+    collectFixed();
+    if (probe) {
+        vec<Lit> implied;
+        for (int i = 0; i < cands.size(); i++) {
+            as.clear();
+            as.push(~cands[i]);
+            if (!solver.implies(as, implied)) {
+                solver.addClause(cands[i]);
+                probed++;
+            }
+        }
+        collectFixed();
+    }
+
+    int size = chunk;
+    while (cands.size() > 0) {
+        int k = size < cands.size() ? size : cands.size();
+        Lit act = lit_Undef;
+        as.clear();
+        if (k == 1)
+            as.push(~cands.last());
+        else {
+            act = mkLit(solver.newVar(l_Undef, false));
+            vec<Lit> ps;
+            ps.push(~act);
+            for (int i = cands.size() - k; i < cands.size(); i++)
+                ps.push(~cands[i]);
+            solver.addClause_(ps);
+            as.push(act);
+        }
+
+        queries++;
+        if (k > 1)
+            solver.setConfBudget(chunk_confl);
+        ret = solver.solveLimited(as);
+        solver.budgetOff();
+        if (ret == l_False) {
+            for (int i = cands.size() - k; i < cands.size(); i++)
+                solver.addClause(cands[i]);
+        } else if (ret == l_True) {
+            int i, j;
+            for (i = j = 0; i < cands.size(); i++)
+                if (solver.modelValue(cands[i]) == l_False)
+                    solver.setPolarity(var(cands[i]), l_Undef);
+                else
+                    cands[j++] = cands[i];
+            filtered += i - j;
+            cands.shrink(i - j);
+        }
+        if (act != lit_Undef)
+            solver.releaseVar(~act);
+        if (ret == l_Undef && interrupted)
+            break;
+        else if (ret == l_Undef)
+            size = k / 2;
+
+        collectFixed();
+        if (verbosity >= 1 && queries % 100 == 0)
+            printf("c %" PRIu64 " queries, %d candidates left, %d in the backbone\n", queries,
+                   cands.size(), backbone.size());
+    }
+
+    for (int i = 0; i < biased.size(); i++)
+        solver.setPolarity(biased[i], l_Undef);
+    return cands.size() > 0 ? l_Undef : l_True;
+}
@@ -0,0 +1,109 @@
+/********************************************************************************[BackboneSolver.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_BackboneSolver_h
+#define Minisat_BackboneSolver_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// BackboneSolver -- the literals true in every model:
+//
+// The candidates are the literals of a first model. Each later query asks for a model falsifying
+// at least one candidate of a chunk (through a clause activated by an assumption): if there is
+// none, the whole chunk is in the backbone and becomes units; otherwise the model drops every
+// candidate it falsifies. Decisions are biased towards falsifying candidates, so that models
+// drop as many as possible, and the chunk size shrinks when queries get hard. Before that, each
+// candidate whose negation fails by unit propagation alone ('implies()') is in the backbone
+// without a search, as is every candidate that later gets fixed at level 0. All queries go to one
+// incremental solver, so learnt clauses are kept.
+
+class BackboneSolver
+{
+   public:
+    // Constructor/Destructor:
+    //
+    BackboneSolver();
+    ~BackboneSolver();
+
+    // Problem specification:
+    //
+    Var newVar();                  // Add a new variable.
+    int nVars() const;             // The current number of variables.
+    bool addClause_(vec<Lit>& ps); // Add a clause (may change 'ps').
+
+    // Solving:
+    //
+    lbool compute(const vec<Var>& vs); // Find the backbone restricted to 'vs' (all variables if
+                                       // empty). Returns l_False if the clauses are unsatisfiable,
+                                       // and l_Undef if interrupted.
+    void interrupt(); // Trigger a (potentially asynchronous) interruption of the solver.
+
+    // Extra results: (read-only member variable)
+    //
+    vec<Lit> backbone; // The backbone literals found.
+
+    // Mode of operation:
+    //
+    int verbosity;
+    int chunk;       // The number of candidates checked by one query (initially).
+    int chunk_confl; // Conflict budget of a query over several candidates.
+    bool probe;      // Check candidates by unit propagation first.
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t queries, probed, filtered;
+
+    Solver solver; // The underlying incremental solver.
+
+   protected:
+    vec<Lit> cands; // The candidates not yet decided.
+    bool interrupted;
+
+    void collectFixed(); // Move the candidates fixed at level 0 to the backbone.
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline Var BackboneSolver::newVar()
+{
+    return solver.newVar();
+}
+inline int BackboneSolver::nVars() const
+{
+    return solver.nVars();
+}
+inline bool BackboneSolver::addClause_(vec<Lit>& ps)
+{
+    return solver.addClause_(ps);
+}
+inline void BackboneSolver::interrupt()
+{
+    interrupted = true;
+    solver.interrupt();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
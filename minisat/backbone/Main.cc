@@ -0,0 +1,159 @@
+/*****************************************************************************************[Main.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#include <errno.h>
+#include <zlib.h>
+
+#include "minisat/core/Dimacs.h"
+#include "minisat/backbone/BackboneSolver.h"
+#include "minisat/utils/Options.h"
+#include "minisat/utils/ParseUtils.h"
+#include "minisat/utils/System.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+
+static BackboneSolver* solver;
+// Terminate by notifying the solver and back out gracefully.
+static void SIGINT_interrupt(int)
+{
+    solver->interrupt();
+}
+
+// Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
+// destructors and may cause deadlocks if a malloc/free function happens to be running (these
+// functions are guarded by locks for multithreaded use).
+static void SIGINT_exit(int)
+{
+    printf("\n");
+    printf("*** INTERRUPTED ***\n");
+    if (solver->verbosity > 0) {
+        solver->solver.printStats();
+        printf("\n");
+        printf("*** INTERRUPTED ***\n");
+    }
+    _exit(1);
+}
+
+//=================================================================================================
+// Main:
+
+int main(int argc, char** argv)
+{
+    try {
+        setUsageHelp(
+            "USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either "
+            "in plain or gzipped DIMACS. The backbone is restricted to the variables of 'c ind' lines if "
+            "any.\n");
+        setX86FPUPrecision();
+
+        // Extra options:
+        //
+        IntOption verb("MAIN", "verb", "Verbosity level (0=silent, 1=some, 2=more).", 1,
+                       IntRange(0, 2));
+        IntOption cpu_lim("MAIN", "cpu-lim", "Limit on CPU time allowed in seconds.\n", 0,
+                          IntRange(0, INT32_MAX));
+        IntOption mem_lim("MAIN", "mem-lim", "Limit on memory usage in megabytes.\n", 0,
+                          IntRange(0, INT32_MAX));
+
+        parseOptions(argc, argv, true);
+
+        BackboneSolver S;
+        double initial_time = cpuTime();
+
+        S.verbosity = verb;
+        S.solver.verbosity = verb > 1 ? 1 : 0;
+
+        solver = &S;
+        // Use signal handlers that forcibly quit until the solver will be able to respond to
+        // interrupts:
+        sigTerm(SIGINT_exit);
+
+        // Try to set resource limits:
+        if (cpu_lim != 0)
+            limitTime(cpu_lim);
+        if (mem_lim != 0)
+            limitMemory(mem_lim);
+
+        if (argc == 1)
+            printf("c Reading from standard input... Use '--help' for help.\n");
+
+        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+        if (in == NULL)
+            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+
+        vec<Var> proj;
+        parse_DIMACS(in, S, false, &proj);
+        gzclose(in);
+        FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
+
+        if (S.verbosity > 0) {
+            printf("c Number of variables:  %12d\n", S.nVars());
+            printf("c Number of clauses:    %12d\n", S.solver.nClauses());
+            printf("c Parse time:           %12.2f s\n", cpuTime() - initial_time);
+        }
+
+        // Change to signal-handlers that will only notify the solver and allow it to terminate
+        // voluntarily:
+        sigTerm(SIGINT_interrupt);
+
+        lbool ret = S.compute(proj);
+
+        if (S.verbosity > 0) {
+            printf("c Queries:              %12" PRIu64 "\n", S.queries);
+            printf("c Found by propagation: %12" PRIu64 "\n", S.probed);
+            printf("c Refuted by models:    %12" PRIu64 "\n", S.filtered);
+            if (ret == l_True)
+                printf("c Backbone size:        %12d\n", S.backbone.size());
+            printf("c CPU time:             %12.2f s\n", cpuTime() - initial_time);
+        }
+
+        printf(ret == l_True ? "s SATISFIABLE\n"
+                             : ret == l_False ? "s UNSATISFIABLE\n" : "s UNKNOWN\n");
+        if (ret == l_True) {
+            printf("v");
+            for (int i = 0; i < S.backbone.size(); i++)
+                printf(" %s%d", sign(S.backbone[i]) ? "-" : "", var(S.backbone[i]) + 1);
+            printf(" 0\n");
+        }
+        if (res != NULL) {
+            if (ret == l_True) {
+                fprintf(res, "SAT\n");
+                for (int i = 0; i < S.backbone.size(); i++)
+                    fprintf(res, "%s%d ", sign(S.backbone[i]) ? "-" : "", var(S.backbone[i]) + 1);
+                fprintf(res, "0\n");
+            } else
+                fprintf(res, ret == l_False ? "UNSAT\n" : "INDET\n");
+            fclose(res);
+        }
+
+        int code = ret == l_True ? 10 : ret == l_False ? 20 : 0;
+#ifdef NDEBUG
+        exit(code); // (faster than "return", which will invoke the destructor for 'Solver')
+#else
+        return code;
+#endif
+    } catch (OutOfMemoryException&) {
+        printf("s UNKNOWN\n");
+        exit(0);
+    }
+}
@@ -0,0 +1,128 @@
+/*****************************************************************************************[Card.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#include "minisat/core/Card.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor:
+
+Card::Card(Solver& s) : Propagator(s), card_props(0), card_conflicts(0), head(0)
+{
+    start.push(0);
+}
+
+void Card::addAtMost(const vec<Lit>& ps, int k)
+{
+    assert(decisionLevel() == 0);
+    assert(0 < k && k < ps.size() - 1);
+    int c = bound.size();
+    for (int i = 0; i < ps.size(); i++) {
+        assert(value(ps[i]) == l_Undef);
+        lits.push(ps[i]);
+        occs.growTo(toInt(ps[i]) + 1);
+        occs[toInt(ps[i])].push(c);
+        implied_by.growTo(var(ps[i]) + 1, -1);
+    }
+    start.push(lits.size());
+    bound.push(k);
+    ntrue.push(0);
+}
+
+//=================================================================================================
+// Propagation:
+
+bool Card::propagate(vec<Lit>& out_conflict)
+{
+    // The solver may remove released variables from the trail at level 0:
+    const vec<Lit>& tr = trail();
+    if (head > tr.size()) {
+        assert(decisionLevel() == 0);
+        head = tr.size();
+    }
+
+    for (; head < tr.size(); head++) {
+        Lit p = tr[head];
+        if (toInt(p) >= occs.size())
+            continue;
+
+        // Count 'p' in all its constraints before looking for a conflict, so that backtracking
+        // can undo the trail entries seen one by one:
+        const vec<int>& cs = occs[toInt(p)];
+        int confl = -1;
+        for (int i = 0; i < cs.size(); i++) {
+            int c = cs[i];
+            ntrue[c]++;
+            if (confl != -1 || ntrue[c] < bound[c])
+                continue;
+            else if (ntrue[c] > bound[c]) {
+                confl = c;
+                continue;
+            }
+
+            // Exactly 'bound' literals are true, so the others must be false:
+            for (int j = start[c]; j < start[c + 1]; j++)
+                if (value(lits[j]) == l_Undef) {
+                    implied_by[var(lits[j])] = c;
+                    card_props++;
+                    enqueue(~lits[j]);
+                }
+        }
+
+        if (confl != -1) {
+            // 'p' and 'bound' other true literals of the constraint:
+            card_conflicts++;
+            out_conflict.clear();
+            out_conflict.push(~p);
+            for (int j = start[confl]; out_conflict.size() <= bound[confl]; j++)
+                if (value(lits[j]) == l_True && lits[j] != p)
+                    out_conflict.push(~lits[j]);
+            head++;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Card::explain(Lit p, vec<Lit>& out_reason)
+{
+    int c = implied_by[var(p)];
+    assert(c != -1);
+    out_reason.push(p);
+    for (int j = start[c]; j < start[c + 1]; j++)
+        if (value(lits[j]) == l_True)
+            out_reason.push(~lits[j]);
+}
+
+void Card::cancelUntil(int trail_size)
+{
+    const vec<Lit>& tr = trail();
+    for (; head > trail_size; head--) {
+        Lit p = tr[head - 1];
+        if (toInt(p) >= occs.size())
+            continue;
+        const vec<int>& cs = occs[toInt(p)];
+        for (int i = 0; i < cs.size(); i++)
+            ntrue[cs[i]]--;
+    }
+}
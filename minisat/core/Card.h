@@ -0,0 +1,79 @@
+/******************************************************************************************[Card.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#ifndef Minisat_Card_h
+#define Minisat_Card_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Card -- cardinality constraints 'at most k of the literals are true':
+//
+// Each constraint keeps the number of its literals that are true on the part of the trail seen so
+// far, which is updated through occurrence lists and undone on backtracking. A constraint with 'k'
+// true literals falsifies all its other literals, and one with more than 'k' is violated. The
+// reasons are built from the literals of the constraint that are true when they are asked for:
+// once a constraint propagates, none of its literals can become true later.
+
+class Card : public Propagator
+{
+   public:
+    Card(Solver& s);
+
+    // Add the constraint 'at most k of ps are true', where 'ps' are unassigned literals over
+    // distinct variables and '0 < k < ps.size() - 1'.
+    void addAtMost(const vec<Lit>& ps, int k);
+    int nCards() const; // The number of constraints added.
+
+    // Propagator interface:
+    //
+    bool propagate(vec<Lit>& out_conflict);
+    void explain(Lit p, vec<Lit>& out_reason);
+    void cancelUntil(int trail_size);
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t card_props, card_conflicts;
+
+   protected:
+    vec<Lit> lits;        // The literals of all constraints, ...
+    vec<int> start;       // ... the start of each constraint in 'lits' (and the end of the last), ...
+    vec<int> bound;       // ... its bound, ...
+    vec<int> ntrue;       // ... and the number of its literals true on the trail seen so far.
+    vec<vec<int> > occs;  // The constraints of each literal (indexed by 'toInt()').
+    vec<int> implied_by;  // The constraint that implied each variable.
+    int head;             // The number of trail entries seen.
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline int Card::nCards() const
+{
+    return bound.size();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
@@ -47,8 +47,23 @@ static void readClause(B& in, Solver& S, vec<Lit>& lits)
     }
 }
 
+// Reads the variables of a projection line 'c ind <vars> 0'.
 template <class B, class Solver>
-static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false)
+static void readProjection(B& in, Solver& S, vec<Var>& proj)
+{
+    for (;;) {
+        int parsed_var = parseInt(in);
+        if (parsed_var == 0)
+            break;
+        Var var = abs(parsed_var) - 1;
+        while (var >= S.nVars())
+            S.newVar();
+        proj.push(var);
+    }
+}
+
+template <class B, class Solver>
+static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false, vec<Var>* proj = NULL)
 {
     vec<Lit> lits;
     int vars = 0;
@@ -68,6 +83,11 @@ static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false)
             } else {
                 printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
             }
+        } else if (*in == 'c' && proj != NULL) {
+            if (eagerMatch(in, "c ind "))
+                readProjection(in, S, *proj);
+            else
+                skipLine(in);
         } else if (*in == 'c' || *in == 'p')
             skipLine(in);
         else {
@@ -80,13 +100,14 @@ static void parse_DIMACS_main(B& in, Solver& S, bool strictp = false)
         printf("PARSE ERROR! DIMACS header mismatch: wrong number of clauses\n");
 }
 
-// Inserts problem into solver.
+// Inserts problem into solver. If 'proj' is given, the variables of 'c ind' lines are added to it.
 //
 template <class Solver>
-static void parse_DIMACS(gzFile input_stream, Solver& S, bool strictp = false)
+static void parse_DIMACS(gzFile input_stream, Solver& S, bool strictp = false,
+                         vec<Var>* proj = NULL)
 {
     StreamBuffer in(input_stream);
-    parse_DIMACS_main(in, S, strictp);
+    parse_DIMACS_main(in, S, strictp, proj);
 }
 
 //=================================================================================================
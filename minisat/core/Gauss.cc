@@ -0,0 +1,507 @@
+/****************************************************************************************[Gauss.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/core/Gauss.h"
+#include "minisat/mtl/Sort.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Bit operations:
+
+static inline bool getBit(const uint64_t* ws, int c)
+{
+    return (ws[c >> 6] >> (c & 63)) & 1;
+}
+static inline void setBit(uint64_t* ws, int c)
+{
+    ws[c >> 6] |= (uint64_t)1 << (c & 63);
+}
+static inline void clearBit(uint64_t* ws, int c)
+{
+    ws[c >> 6] &= ~((uint64_t)1 << (c & 63));
+}
+
+static inline int popCount(uint64_t w)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(w);
+#else
+    int n = 0;
+    for (; w != 0; w &= w - 1)
+        n++;
+    return n;
+#endif
+}
+
+static inline int lowestBit(uint64_t w)
+{
+    assert(w != 0);
+#if defined(__GNUC__)
+    return __builtin_ctzll(w);
+#else
+    int i = 0;
+    for (; (w & 1) == 0; w >>= 1)
+        i++;
+    return i;
+#endif
+}
+
+// The first column set in both 'a' and 'b' other than 'skip' (or -1):
+static inline int firstCommon(const uint64_t* a, const uint64_t* b, int nwords, int skip)
+{
+    for (int i = 0; i < nwords; i++) {
+        uint64_t w = a[i] & b[i];
+        if ((skip >> 6) == i)
+            w &= ~((uint64_t)1 << (skip & 63));
+        if (w != 0)
+            return (i << 6) + lowestBit(w);
+    }
+    return -1;
+}
+
+static inline bool parity(const uint64_t* a, const uint64_t* b, int nwords)
+{
+    int n = 0;
+    for (int i = 0; i < nwords; i++)
+        n += popCount(a[i] & b[i]);
+    return n & 1;
+}
+
+//=================================================================================================
+// Constructor/Destructor:
+
+Gauss::Gauss(Solver& s)
+    : Propagator(s),
+      gauss_props(0),
+      gauss_conflicts(0),
+      pivots(0),
+      built_xors(0),
+      conflicting(false),
+      head(0)
+{
+}
+
+Gauss::~Gauss()
+{
+    for (int i = 0; i < matrices.size(); i++)
+        delete matrices[i];
+}
+
+// Duplicate variables cancel out. The matrices are (re)built at the next propagation at level 0.
+void Gauss::addXor(const vec<Var>& vs, bool rhs)
+{
+    assert(decisionLevel() == 0);
+    int start = xor_vars.size();
+    for (int i = 0; i < vs.size(); i++)
+        xor_vars.push(vs[i]);
+    sort(&xor_vars[start], vs.size());
+
+    int i, j;
+    for (i = j = start; i < xor_vars.size(); i++)
+        if (i + 1 < xor_vars.size() && xor_vars[i] == xor_vars[i + 1])
+            i++;
+        else
+            xor_vars[j++] = xor_vars[i];
+    xor_vars.shrink(i - j);
+
+    if (xor_vars.size() == start) {
+        // An empty constraint:
+        conflicting |= rhs;
+        return;
+    }
+    xor_ends.push(xor_vars.size());
+    xor_rhs.push(rhs);
+}
+
+//=================================================================================================
+// Building matrices:
+
+static int findRoot(vec<int>& parent, int x)
+{
+    while (parent[x] != x)
+        x = parent[x] = parent[parent[x]];
+    return x;
+}
+
+// Split the constraints into independent matrices and reduce each of them to echelon form.
+void Gauss::build()
+{
+    assert(decisionLevel() == 0);
+    for (int i = 0; i < matrices.size(); i++)
+        delete matrices[i];
+    matrices.clear();
+    pending.clear();
+    snaps.clear();
+    snap_start.clear();
+    snap_pos.clear();
+    snap_mat.clear();
+    built_xors = nXors();
+
+    // Connect the variables of each constraint:
+    Var max_var = -1;
+    for (int i = 0; i < xor_vars.size(); i++)
+        if (xor_vars[i] > max_var)
+            max_var = xor_vars[i];
+    vec<int> parent(max_var + 1);
+    for (int i = 0; i < parent.size(); i++)
+        parent[i] = i;
+    for (int i = 0, start = 0; i < xor_ends.size(); start = xor_ends[i++])
+        for (int j = start + 1; j < xor_ends[i]; j++)
+            parent[findRoot(parent, xor_vars[j])] = findRoot(parent, xor_vars[start]);
+
+    mat_of.clear();
+    mat_of.growTo(max_var + 1, -1);
+    col_of.clear();
+    col_of.growTo(max_var + 1, -1);
+    snap_of.clear();
+    snap_of.growTo(max_var + 1, -1);
+
+    // Collect the constraints and variables of each component:
+    vec<int> comp(max_var + 1, -1);
+    vec<vec<int> > comp_xors;
+    vec<vec<Var> > comp_vars;
+    for (int i = 0, start = 0; i < xor_ends.size(); start = xor_ends[i++]) {
+        int root = findRoot(parent, xor_vars[start]);
+        if (comp[root] == -1) {
+            comp[root] = comp_xors.size();
+            comp_xors.push();
+            comp_vars.push();
+        }
+        comp_xors[comp[root]].push(i);
+    }
+    for (Var v = 0; v <= max_var; v++)
+        if (parent[v] != v || comp[v] != -1) {
+            int root = findRoot(parent, v);
+            if (comp[root] != -1)
+                comp_vars[comp[root]].push(v);
+        }
+
+    for (int i = 0; i < comp_xors.size(); i++)
+        buildMatrix(comp_xors[i], comp_vars[i]);
+
+    // Take in the current assignment:
+    head = trail().size();
+    for (int i = 0; i < matrices.size(); i++) {
+        Matrix& m = *matrices[i];
+        for (int c = 0; c < m.vars.size(); c++)
+            if (value(m.vars[c]) == l_Undef)
+                setBit(&m.unassigned[0], c);
+            else if (value(m.vars[c]) == l_True)
+                setBit(&m.truth[0], c);
+        for (int r = 0; r < m.nrows; r++)
+            markDirty(m, r);
+        m.pending = true;
+        pending.push(i);
+    }
+}
+
+void Gauss::buildMatrix(const vec<int>& xs, const vec<Var>& vs)
+{
+    Matrix* mp = new Matrix;
+    Matrix& m = *mp;
+    m.nrows = xs.size();
+    m.nwords = (vs.size() + 63) >> 6;
+    vs.copyTo(m.vars);
+    m.rows.growTo(m.nrows * m.nwords, 0);
+    m.rhs.growTo(m.nrows, 0);
+    m.basic.growTo(m.nrows, -1);
+    m.unassigned.growTo(m.nwords, 0);
+    m.truth.growTo(m.nwords, 0);
+    m.dirty.growTo(m.nrows, 0);
+    m.pending = false;
+
+    int mi = matrices.size();
+    for (int c = 0; c < vs.size(); c++) {
+        mat_of[vs[c]] = mi;
+        col_of[vs[c]] = c;
+    }
+    for (int r = 0; r < xs.size(); r++) {
+        int end = xor_ends[xs[r]];
+        for (int j = xs[r] == 0 ? 0 : xor_ends[xs[r] - 1]; j < end; j++)
+            setBit(m.row(r), col_of[xor_vars[j]]);
+        m.rhs[r] = xor_rhs[xs[r]];
+    }
+
+    // Gauss-Jordan elimination:
+    int rank = 0;
+    for (int c = 0; c < vs.size() && rank < m.nrows; c++) {
+        int r;
+        for (r = rank; r < m.nrows && !getBit(m.row(r), c); r++)
+            ;
+        if (r == m.nrows)
+            continue;
+
+        for (int i = 0; i < m.nwords; i++) {
+            uint64_t w = m.row(r)[i];
+            m.row(r)[i] = m.row(rank)[i];
+            m.row(rank)[i] = w;
+        }
+        char b = m.rhs[r];
+        m.rhs[r] = m.rhs[rank];
+        m.rhs[rank] = b;
+
+        m.basic[rank] = c;
+        for (r = 0; r < m.nrows; r++)
+            if (r != rank && getBit(m.row(r), c)) {
+                for (int i = 0; i < m.nwords; i++)
+                    m.row(r)[i] ^= m.row(rank)[i];
+                m.rhs[r] ^= m.rhs[rank];
+            }
+        rank++;
+    }
+
+    // Rows beyond the rank are empty:
+    for (int r = rank; r < m.nrows; r++)
+        conflicting |= m.rhs[r];
+    m.nrows = rank;
+    m.rows.shrink(m.rows.size() - rank * m.nwords);
+    m.rhs.shrink(m.rhs.size() - rank);
+    m.basic.shrink(m.basic.size() - rank);
+    m.dirty.shrink(m.dirty.size() - rank);
+
+    m.watch.growTo(m.nrows, -1);
+    m.watches.growTo(vs.size());
+    for (int r = 0; r < m.nrows; r++)
+        m.watches[m.basic[r]].push(r);
+
+    matrices.push(mp);
+}
+
+//=================================================================================================
+// Propagation:
+
+void Gauss::markDirty(Matrix& m, int r)
+{
+    if (!m.dirty[r]) {
+        m.dirty[r] = 1;
+        m.dirty_rows.push(r);
+    }
+}
+
+// Mark the rows watching column 'c' of matrix 'mi' dirty, and forget the rows that stopped watching
+// it.
+void Gauss::markWatchers(Matrix& m, int mi, int c)
+{
+    vec<int>& ws = m.watches[c];
+    int i, j;
+    for (i = j = 0; i < ws.size(); i++)
+        if (m.basic[ws[i]] == c || m.watch[ws[i]] == c) {
+            markDirty(m, ws[i]);
+            ws[j++] = ws[i];
+        }
+    ws.shrink(i - j);
+    if (m.dirty_rows.size() > 0 && !m.pending) {
+        m.pending = true;
+        pending.push(mi);
+    }
+}
+
+// Make 'c' the basic column of row 'r', eliminating it from all other rows.
+void Gauss::pivot(Matrix& m, int r, int c)
+{
+    const uint64_t* pr = m.row(r);
+    for (int k = 0; k < m.nrows; k++)
+        if (k != r && getBit(m.row(k), c)) {
+            uint64_t* pk = m.row(k);
+            for (int i = 0; i < m.nwords; i++)
+                pk[i] ^= pr[i];
+            m.rhs[k] ^= m.rhs[r];
+            markDirty(m, k);
+        }
+    m.basic[r] = c;
+    if (m.watch[r] == c)
+        m.watch[r] = -1;
+    else
+        m.watches[c].push(r);
+    pivots++;
+}
+
+// Watch the non-basic column of the fully assigned row 'r' that was assigned last, so the row is
+// inspected again as soon as backtracking unassigns any of its columns.
+void Gauss::watchLast(Matrix& m, int r)
+{
+    const uint64_t* row = m.row(r);
+    int best = -1, best_level = -1;
+    for (int i = 0; i < m.nwords; i++)
+        for (uint64_t w = row[i]; w != 0; w &= w - 1) {
+            int c = i * 64 + lowestBit(w);
+            if (c != m.basic[r] && level(m.vars[c]) > best_level)
+                best = c, best_level = level(m.vars[c]);
+        }
+    if (best != -1 && best != m.watch[r])
+        m.watches[best].push(r);
+    m.watch[r] = best;
+}
+
+// Returns FALSE if row 'r' is violated. Unless the row is propagating or violated, its basic column
+// and one more column of the row are left unassigned and watched.
+bool Gauss::propagateRow(Matrix& m, int mi, int r, vec<Lit>& out_conflict)
+{
+    uint64_t* row = m.row(r);
+    int b = m.basic[r];
+
+    if (!getBit(&m.unassigned[0], b)) {
+        int c = firstCommon(row, &m.unassigned[0], m.nwords, -1);
+        if (c == -1) {
+            watchLast(m, r);
+            if (parity(row, &m.truth[0], m.nwords) == (bool)m.rhs[r])
+                return true;
+            gauss_conflicts++;
+            out_conflict.clear();
+            rowLits(m, row, var_Undef, out_conflict);
+            return false;
+        }
+        pivot(m, r, c);
+        b = c;
+    }
+
+    int w = m.watch[r];
+    if (w != -1 && w != b && getBit(row, w) && getBit(&m.unassigned[0], w))
+        return true;
+    if ((w = firstCommon(row, &m.unassigned[0], m.nwords, b)) != -1) {
+        m.watch[r] = w;
+        m.watches[w].push(r);
+        return true;
+    }
+
+    // All variables but the basic one are assigned:
+    bool val = parity(row, &m.truth[0], m.nwords) != (bool)m.rhs[r];
+    Var v = m.vars[b];
+    snap_of[v] = snap_pos.size();
+    snap_start.push(snaps.size());
+    snap_pos.push(trail().size());
+    snap_mat.push(mi);
+    for (int i = 0; i < m.nwords; i++)
+        snaps.push(row[i]);
+
+    clearBit(&m.unassigned[0], b);
+    if (val)
+        setBit(&m.truth[0], b);
+    gauss_props++;
+    enqueue(mkLit(v, !val));
+    return true;
+}
+
+bool Gauss::propagate(vec<Lit>& out_conflict)
+{
+    if (built_xors < nXors() && decisionLevel() == 0)
+        build();
+    if (conflicting) {
+        out_conflict.clear();
+        return false;
+    }
+
+    // The solver may remove released variables from the trail at level 0:
+    const vec<Lit>& tr = trail();
+    if (head > tr.size()) {
+        assert(decisionLevel() == 0);
+        head = tr.size();
+        snaps.clear();
+        snap_start.clear();
+        snap_pos.clear();
+        snap_mat.clear();
+    }
+
+    for (; head < tr.size(); head++) {
+        Var v = var(tr[head]);
+        if (v >= mat_of.size() || mat_of[v] == -1)
+            continue;
+        Matrix& m = *matrices[mat_of[v]];
+        int c = col_of[v];
+        if (!getBit(&m.unassigned[0], c))
+            continue; // (implied by this matrix)
+        clearBit(&m.unassigned[0], c);
+        if (!sign(tr[head]))
+            setBit(&m.truth[0], c);
+
+        markWatchers(m, mat_of[v], c);
+    }
+
+    for (int i = 0; i < pending.size(); i++) {
+        int mi = pending[i];
+        Matrix& m = *matrices[mi];
+        while (m.dirty_rows.size() > 0) {
+            int r = m.dirty_rows.last();
+            m.dirty_rows.pop();
+            m.dirty[r] = 0;
+            if (!propagateRow(m, mi, r, out_conflict)) {
+                // Keep this and the remaining matrices pending:
+                int j = 0;
+                for (int k = i; k < pending.size(); k++)
+                    pending[j++] = pending[k];
+                pending.shrink(pending.size() - j);
+                return false;
+            }
+        }
+        m.pending = false;
+    }
+    pending.clear();
+
+    return true;
+}
+
+// The literals of the variables in 'row' (except 'skip') under the current assignment, all false.
+void Gauss::rowLits(const Matrix& m, const uint64_t* row, Var skip, vec<Lit>& out)
+{
+    for (int i = 0; i < m.nwords; i++)
+        for (uint64_t w = row[i]; w != 0; w &= w - 1) {
+            Var v = m.vars[(i << 6) + lowestBit(w)];
+            if (v != skip) {
+                assert(value(v) != l_Undef);
+                out.push(mkLit(v, value(v) == l_True));
+            }
+        }
+}
+
+void Gauss::explain(Lit p, vec<Lit>& out_reason)
+{
+    int s = snap_of[var(p)];
+    assert(s >= 0 && s < snap_pos.size() && trail()[snap_pos[s]] == p);
+    out_reason.clear();
+    out_reason.push(p);
+    rowLits(*matrices[snap_mat[s]], &snaps[snap_start[s]], var(p), out_reason);
+}
+
+// Rows watching a column that becomes unassigned are inspected again: rows that were propagating or
+// fully assigned watch the column assigned last among their basic and other columns.
+void Gauss::cancelUntil(int trail_size)
+{
+    const vec<Lit>& tr = trail();
+    for (int i = tr.size() - 1; i >= trail_size; i--) {
+        Var v = var(tr[i]);
+        if (v >= mat_of.size() || mat_of[v] == -1)
+            continue;
+        Matrix& m = *matrices[mat_of[v]];
+        int c = col_of[v];
+        setBit(&m.unassigned[0], c);
+        clearBit(&m.truth[0], c);
+        markWatchers(m, mat_of[v], c);
+    }
+    if (head > trail_size)
+        head = trail_size;
+
+    while (snap_pos.size() > 0 && snap_pos.last() >= trail_size) {
+        snaps.shrink(snaps.size() - snap_start.last());
+        snap_start.pop();
+        snap_pos.pop();
+        snap_mat.pop();
+    }
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************************[Gauss.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Gauss_h
+#define Minisat_Gauss_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Gauss -- Gauss-Jordan elimination over XOR constraints:
+//
+// The constraints are split into independent matrices (no variable shared between two of them).
+// Each matrix is a bit-packed system of equations over GF(2), kept in reduced row echelon form:
+// every row has a basic column that occurs in no other row. As long as a row has an unassigned
+// variable, its basic column is moved to one of them (eliminating that column from the other rows),
+// so a row implies its basic variable as soon as all other variables are assigned, and a row
+// without unassigned variables is checked for a conflict. Like clauses, rows are only inspected
+// when one of two watched columns (the basic one and another one) is assigned. The matrix is not
+// restored on backtracking; any echelon form of the system will do. Reasons are taken from copies
+// of the rows at the time of propagation.
+
+class Gauss : public Propagator
+{
+   public:
+    Gauss(Solver& s);
+    ~Gauss();
+
+    void addXor(const vec<Var>& vs, bool rhs); // Add the constraint 'vs[0] ^ ... ^ vs[n-1] = rhs'.
+    int nXors() const;                         // The number of constraints added.
+    int nMatrices() const;                     // The number of matrices built (so far).
+
+    // Propagator interface:
+    //
+    bool propagate(vec<Lit>& out_conflict);
+    void explain(Lit p, vec<Lit>& out_reason);
+    void cancelUntil(int trail_size);
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t gauss_props, gauss_conflicts, pivots;
+
+   protected:
+    struct Matrix {
+        int nrows, nwords;
+        vec<Var> vars;            // The variable of each column.
+        vec<uint64_t> rows;       // The rows ('nwords' words each), bit 'c' of a row is column 'c'.
+        vec<char> rhs;            // The right-hand side of each row.
+        vec<int> basic;           // The basic column of each row.
+        vec<int> watch;           // Another watched column of each row (or -1).
+        vec<vec<int> > watches;   // The rows watching each column (possibly out of date).
+        vec<uint64_t> unassigned; // Columns with an unassigned variable.
+        vec<uint64_t> truth;      // Columns with a variable assigned true.
+        vec<int> dirty_rows;      // Rows that must be inspected.
+        vec<char> dirty;
+        bool pending; // The matrix is in 'pending'.
+
+        uint64_t* row(int r)
+        {
+            return &rows[r * nwords];
+        }
+    };
+
+    vec<Var> xor_vars;  // The variables of all constraints added, ...
+    vec<int> xor_ends;  // ... the end of each constraint in 'xor_vars', ...
+    vec<char> xor_rhs;  // ... and its right-hand side.
+    int built_xors;     // The number of constraints that the matrices were built from.
+    bool conflicting;   // The constraints are inconsistent by themselves.
+
+    vec<Matrix*> matrices;
+    vec<int> mat_of;    // The matrix of each variable (or -1).
+    vec<int> col_of;    // The column of each variable in its matrix.
+    vec<int> pending;   // Matrices with dirty rows.
+    int head;           // The number of trail entries seen.
+
+    vec<uint64_t> snaps;  // Copies of the rows that implied the literals on the trail, ...
+    vec<int> snap_start;  // ... the start of each copy in 'snaps', ...
+    vec<int> snap_pos;    // ... the trail position of the implied literal, ...
+    vec<int> snap_mat;    // ... and its matrix.
+    vec<int> snap_of;     // The copy for each implied variable.
+
+    void build();
+    void buildMatrix(const vec<int>& xs, const vec<Var>& vs);
+    void markDirty(Matrix& m, int r);
+    void markWatchers(Matrix& m, int mi, int c);
+    void watchLast(Matrix& m, int r);
+    void pivot(Matrix& m, int r, int c);
+    bool propagateRow(Matrix& m, int mi, int r, vec<Lit>& out_conflict);
+    void rowLits(const Matrix& m, const uint64_t* row, Var skip, vec<Lit>& out);
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline int Gauss::nXors() const
+{
+    return xor_ends.size();
+}
+inline int Gauss::nMatrices() const
+{
+    return matrices.size();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <zlib.h>
 
 #include "minisat/core/Dimacs.h"
+#include "minisat/core/Opb.h"
 #include "minisat/core/Solver.h"
 #include "minisat/utils/Options.h"
 #include "minisat/utils/ParseUtils.h"
@@ -39,6 +40,12 @@ static void SIGINT_interrupt(int)
     solver->interrupt();
 }
 
+// Print the statistics at the next conflict, without stopping:
+static void SIGUSR1_stats(int)
+{
+    solver->requestStats();
+}
+
 // Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
 // destructors and may cause deadlocks if a malloc/free function happens to be running (these
 // functions are guarded by locks for multithreaded use).
@@ -54,6 +61,18 @@ static void SIGINT_exit(int)
     _exit(1);
 }
 
+// Write the statistics of 'S' to 'file' (if given) as one JSON object:
+static void writeStatsJson(const Solver& S, const char* file)
+{
+    if (file == NULL)
+        return;
+    FILE* f = fopen(file, "wb");
+    if (f == NULL)
+        printf("ERROR! Could not open file: %s\n", file);
+    else
+        S.printStatsJson(f), fclose(f);
+}
+
 //=================================================================================================
 // Main:
 
@@ -62,7 +81,7 @@ int main(int argc, char** argv)
     try {
         setUsageHelp(
             "USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either "
-            "in plain or gzipped DIMACS.\n");
+            "in plain or gzipped DIMACS (or OPB, see '-opb').\n");
         setX86FPUPrecision();
 
         // Extra options:
@@ -73,7 +92,33 @@ int main(int argc, char** argv)
                           IntRange(0, INT32_MAX));
         IntOption mem_lim("MAIN", "mem-lim", "Limit on memory usage in megabytes.\n", 0,
                           IntRange(0, INT32_MAX));
+        IntOption wall_lim("MAIN", "wall-lim",
+                           "Limit on wall-clock time allowed in seconds (checked by the solver).\n",
+                           0, IntRange(0, INT32_MAX));
+        IntOption tick_lim("MAIN", "tick-lim",
+                           "Limit on the ticks of search (watcher visits and clause literal "
+                           "accesses) in millions, for machine independent timeouts.\n",
+                           0, IntRange(0, INT32_MAX));
         BoolOption strictp("MAIN", "strict", "Validate DIMACS header during parsing.", false);
+        BoolOption opb("MAIN", "opb", "Read the input in OPB (pseudo-Boolean) format.", false);
+        StringOption stats_json("MAIN", "stats-json",
+                                "If given, write the statistics and phase times as JSON to this "
+                                "file.");
+        BoolOption hw_counters("MAIN", "hw-counters",
+                               "Count hardware events (cycles, instructions, cache and branch "
+                               "misses) in each phase (Linux only, slows the solver down).",
+                               false);
+        IntOption progress_fd("MAIN", "progress-fd",
+                              "Write JSON progress records to this file descriptor (-1 means "
+                              "none).",
+                              -1, IntRange(-1, INT32_MAX));
+        DoubleOption progress_int("MAIN", "progress-int",
+                                  "Wall-clock seconds between progress records.", 1.0,
+                                  DoubleRange(0, true, HUGE_VAL, false));
+        IntOption models("MAIN", "models",
+                         "Enumerate up to this many models (0 means all), projected onto the "
+                         "variables of 'c ind' lines if any.\n",
+                         1, IntRange(0, INT32_MAX));
 
         parseOptions(argc, argv, true);
 
@@ -81,17 +126,26 @@ int main(int argc, char** argv)
         double initial_time = cpuTime();
 
         S.verbosity = verb;
+        if (hw_counters && !S.prof.openHw())
+            printf("WARNING: hardware counters are not available ('perf_event_open()' failed)\n");
+        S.progress_fd = progress_fd;
+        S.progress_int = progress_int;
 
         solver = &S;
         // Use signal handlers that forcibly quit until the solver will be able to respond to
         // interrupts:
         sigTerm(SIGINT_exit);
+        sigStats(SIGUSR1_stats);
 
         // Try to set resource limits:
         if (cpu_lim != 0)
             limitTime(cpu_lim);
         if (mem_lim != 0)
             limitMemory(mem_lim);
+        if (wall_lim != 0)
+            S.setTimeBudget(wall_lim);
+        if (tick_lim != 0)
+            S.setTickBudget((int64_t)tick_lim * 1000000);
 
         if (argc == 1)
             printf("Reading from standard input... Use '--help' for help.\n");
@@ -109,7 +163,11 @@ int main(int argc, char** argv)
                 "|\n");
         }
 
-        parse_DIMACS(in, S, (bool)strictp);
+        vec<Var> proj;
+        if (opb)
+            parse_OPB(in, S);
+        else
+            parse_DIMACS(in, S, (bool)strictp, &proj);
         gzclose(in);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
 
@@ -145,18 +203,51 @@ int main(int argc, char** argv)
                 printf("\n");
             }
             printf("UNSATISFIABLE\n");
+            writeStatsJson(S, stats_json);
             exit(20);
         }
 
         vec<Lit> dummy;
-        lbool ret = S.solveLimited(dummy);
+        lbool ret = l_Undef;
+        if (models == 1)
+            ret = S.solveLimited(dummy);
+        else {
+            // Enumerate the models, writing each (projected) to the result file:
+            if (proj.size() == 0)
+                for (Var v = 0; v < S.nVars(); v++)
+                    proj.push(v);
+            S.startEnum(proj);
+            while ((models == 0 || S.enumerated < (uint64_t)models) &&
+                   (ret = S.nextModel()) == l_True)
+                if (res != NULL) {
+                    if (S.enumerated == 1)
+                        fprintf(res, "SAT\n");
+                    for (int i = 0; i < proj.size(); i++)
+                        fprintf(res, "%s%s%d", (i == 0) ? "" : " ",
+                                (S.model[proj[i]] == l_True) ? "" : "-", proj[i] + 1);
+                    fprintf(res, " 0\n");
+                }
+            S.stopEnum();
+            if (S.enumerated > 0)
+                ret = l_True;
+            else if (res != NULL)
+                fprintf(res, ret == l_False ? "UNSAT\n" : "INDET\n");
+        }
         if (S.verbosity > 0) {
             S.printStats();
+            if (models != 1)
+                printf("models                : %-12" PRIu64
+                       "   (%.2f literals per blocking clause)\n",
+                       S.enumerated,
+                       S.enumerated == 0 ? 0 : (double)S.block_literals / S.enumerated);
             printf("\n");
         }
         printf(ret == l_True ? "SATISFIABLE\n"
                              : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
-        if (res != NULL) {
+        writeStatsJson(S, stats_json);
+        if (res != NULL && models != 1)
+            fclose(res);
+        else if (res != NULL) {
             if (ret == l_True) {
                 fprintf(res, "SAT\n");
                 for (int i = 0; i < S.nVars(); i++)
@@ -0,0 +1,131 @@
+/*******************************************************************************************[Opb.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#ifndef Minisat_Opb_h
+#define Minisat_Opb_h
+
+#include <stdio.h>
+
+#include "minisat/core/SolverTypes.h"
+#include "minisat/utils/ParseUtils.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// OPB Parser:
+//
+// Linear pseudo-Boolean problems as in the pseudo-Boolean competitions: lines starting with '*' are
+// comments, and a constraint is a sum of terms '<weight> x<index>' (or '~x<index>' for a negated
+// variable), followed by '>=', '<=' or '=', an integer and ';'. The objective function ('min:' or
+// 'max:') is skipped; only satisfiability is decided.
+
+template <class B, class Solver>
+static Lit parseOpbLit(B& in, Solver& S)
+{
+    bool neg = false;
+    if (*in == '~')
+        neg = true, ++in;
+    if (*in != 'x')
+        printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+    ++in;
+    int var = parseInt(in) - 1;
+    if (var < 0)
+        printf("PARSE ERROR! Invalid variable: x%d\n", var + 1), exit(3);
+    while (var >= S.nVars())
+        S.newVar();
+    return mkLit(var, neg);
+}
+
+template <class B, class Solver>
+static void readPbTerms(B& in, Solver& S, vec<Lit>& lits, vec<int64_t>& ws)
+{
+    lits.clear();
+    ws.clear();
+    for (;;) {
+        skipWhitespace(in);
+        if (*in == ';' || *in == '>' || *in == '<' || *in == '=' || *in == EOF)
+            break;
+        ws.push(*in == 'x' || *in == '~' ? 1 : parseInt64(in));
+        skipWhitespace(in);
+        lits.push(parseOpbLit(in, S));
+        skipWhitespace(in);
+        if (*in == 'x' || *in == '~')
+            printf("PARSE ERROR! Non-linear terms are not supported\n"), exit(3);
+    }
+}
+
+template <class B, class Solver>
+static void parse_OPB_main(B& in, Solver& S)
+{
+    vec<Lit> lits;
+    vec<int64_t> ws;
+    for (;;) {
+        skipWhitespace(in);
+        if (*in == EOF)
+            break;
+        else if (*in == '*')
+            skipLine(in);
+        else if (*in == 'm') {
+            if (!eagerMatch(in, "min:") && !eagerMatch(in, "ax:")) // ('m' is consumed by the first)
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            readPbTerms(in, S, lits, ws);
+            if (*in != ';')
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+        } else {
+            readPbTerms(in, S, lits, ws);
+            bool geq = false, leq = false;
+            if (eagerMatch(in, ">="))
+                geq = true;
+            else if (eagerMatch(in, "<="))
+                leq = true;
+            else if (!eagerMatch(in, "="))
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            int64_t k = parseInt64(in);
+            skipWhitespace(in);
+            if (*in != ';')
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+
+            if (!leq)
+                S.addPB(lits, ws, k);
+            if (!geq) {
+                for (int i = 0; i < ws.size(); i++)
+                    ws[i] = -ws[i];
+                S.addPB(lits, ws, -k);
+            }
+        }
+    }
+}
+
+// Inserts problem into solver.
+//
+template <class Solver>
+static void parse_OPB(gzFile input_stream, Solver& S)
+{
+    StreamBuffer in(input_stream);
+    parse_OPB_main(in, S);
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
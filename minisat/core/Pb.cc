@@ -0,0 +1,145 @@
+/*******************************************************************************************[Pb.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#include "minisat/core/Pb.h"
+
+using namespace Minisat;
+
+const uint64_t Pb::unseen;
+
+//=================================================================================================
+// Constructor:
+
+Pb::Pb(Solver& s) : Propagator(s), pb_props(0), pb_conflicts(0), stamp(0), head(0)
+{
+    start.push(0);
+}
+
+void Pb::addPB(const vec<Lit>& ps, const vec<int64_t>& ws, int64_t k)
+{
+    assert(decisionLevel() == 0);
+    assert(ps.size() == ws.size());
+    int c = slack.size();
+    int64_t sum = 0;
+    for (int i = 0; i < ps.size(); i++) {
+        assert(value(ps[i]) == l_Undef);
+        assert(ws[i] > 0 && (i == 0 || ws[i] <= ws[i - 1]));
+        lits.push(ps[i]);
+        weights.push(ws[i]);
+        sum += ws[i];
+        occs.growTo(toInt(~ps[i]) + 1);
+        occs[toInt(~ps[i])].push(Occ(c, ws[i]));
+        implied_by.growTo(var(ps[i]) + 1, -1);
+        implied_at.growTo(var(ps[i]) + 1, 0);
+        seen_at.growTo(var(ps[i]) + 1, unseen);
+    }
+    assert(ps.size() == 0 || sum - k >= ws[0]);
+    start.push(lits.size());
+    slack.push(sum - k);
+}
+
+//=================================================================================================
+// Propagation:
+
+// The false literals of constraint 'c' seen up to time stamp 'until', except 'skip'.
+void Pb::falseLits(int c, uint64_t until, Lit skip, vec<Lit>& out)
+{
+    for (int j = start[c]; j < start[c + 1]; j++) {
+        Lit q = lits[j];
+        if (q != skip && value(q) == l_False && seen_at[var(q)] <= until)
+            out.push(q);
+    }
+}
+
+bool Pb::propagate(vec<Lit>& out_conflict)
+{
+    // The solver may remove released variables from the trail at level 0:
+    const vec<Lit>& tr = trail();
+    if (head > tr.size()) {
+        assert(decisionLevel() == 0);
+        head = tr.size();
+    }
+
+    for (; head < tr.size(); head++) {
+        Lit p = tr[head];
+        if (var(p) < seen_at.size())
+            seen_at[var(p)] = ++stamp;
+        if (toInt(p) >= occs.size())
+            continue;
+
+        // Update all constraints of 'p' before looking for a conflict, so that backtracking can
+        // undo the trail entries seen one by one:
+        const vec<Occ>& os = occs[toInt(p)];
+        int confl = -1;
+        for (int i = 0; i < os.size(); i++) {
+            int c = os[i].pb;
+            slack[c] -= os[i].weight;
+            if (confl != -1 || slack[c] >= weights[start[c]])
+                continue;
+            else if (slack[c] < 0) {
+                confl = c;
+                continue;
+            }
+
+            // Literals weighing more than the slack must be true:
+            for (int j = start[c]; j < start[c + 1] && weights[j] > slack[c]; j++)
+                if (value(lits[j]) == l_Undef) {
+                    implied_by[var(lits[j])] = c;
+                    implied_at[var(lits[j])] = stamp;
+                    pb_props++;
+                    enqueue(lits[j]);
+                }
+        }
+
+        if (confl != -1) {
+            pb_conflicts++;
+            out_conflict.clear();
+            falseLits(confl, stamp, lit_Undef, out_conflict);
+            head++;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Pb::explain(Lit p, vec<Lit>& out_reason)
+{
+    int c = implied_by[var(p)];
+    assert(c != -1);
+    out_reason.push(p);
+    falseLits(c, implied_at[var(p)], p, out_reason);
+}
+
+void Pb::cancelUntil(int trail_size)
+{
+    const vec<Lit>& tr = trail();
+    for (; head > trail_size; head--) {
+        Lit p = tr[head - 1];
+        if (var(p) < seen_at.size())
+            seen_at[var(p)] = unseen;
+        if (toInt(p) >= occs.size())
+            continue;
+        const vec<Occ>& os = occs[toInt(p)];
+        for (int i = 0; i < os.size(); i++)
+            slack[os[i].pb] += os[i].weight;
+    }
+}
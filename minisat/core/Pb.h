@@ -0,0 +1,95 @@
+/********************************************************************************************[Pb.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#ifndef Minisat_Pb_h
+#define Minisat_Pb_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// Pb -- linear pseudo-Boolean constraints 'w[0]*ps[0] + ... + w[n-1]*ps[n-1] >= k':
+//
+// Each constraint keeps its slack, the total weight of its literals that are not false on the part
+// of the trail seen so far minus 'k', which is updated through occurrence lists and undone on
+// backtracking. A negative slack is a conflict, and every unassigned literal weighing more than the
+// slack is implied. The reason of an implied literal is made of the false literals of the
+// constraint that were seen before it, which are told apart from later ones by time stamps.
+
+class Pb : public Propagator
+{
+   public:
+    Pb(Solver& s);
+
+    // Add the constraint 'ws[0]*ps[0] + ... + ws[n-1]*ps[n-1] >= k', where 'ps' are unassigned
+    // literals over distinct variables, the weights are positive and sorted in decreasing order,
+    // and the constraint implies no literal at level 0.
+    void addPB(const vec<Lit>& ps, const vec<int64_t>& ws, int64_t k);
+    int nPBs() const; // The number of constraints added.
+
+    // Propagator interface:
+    //
+    bool propagate(vec<Lit>& out_conflict);
+    void explain(Lit p, vec<Lit>& out_reason);
+    void cancelUntil(int trail_size);
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t pb_props, pb_conflicts;
+
+   protected:
+    struct Occ {
+        int pb;         // A constraint ...
+        int64_t weight; // ... losing this weight of slack when the literal becomes true.
+        Occ(int p, int64_t w) : pb(p), weight(w)
+        {
+        }
+    };
+
+    vec<Lit> lits;         // The literals of all constraints, ...
+    vec<int64_t> weights;  // ... their weights, ...
+    vec<int> start;        // ... the start of each constraint in 'lits' (and the end of the last), ...
+    vec<int64_t> slack;    // ... and its slack on the trail seen so far.
+    vec<vec<Occ> > occs;   // The constraints falsified by each literal (indexed by 'toInt()').
+    vec<int> implied_by;   // The constraint that implied each variable, ...
+    vec<uint64_t> implied_at; // ... and the time stamp at that point.
+    vec<uint64_t> seen_at;    // The time stamp of each variable seen on the trail (or 'unseen').
+    uint64_t stamp;           // The number of trail entries ever seen.
+    int head;                 // The number of trail entries seen.
+
+    static const uint64_t unseen = ~(uint64_t)0;
+
+    void falseLits(int c, uint64_t until, Lit skip, vec<Lit>& out);
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline int Pb::nPBs() const
+{
+    return slack.size();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
@@ -0,0 +1,82 @@
+/************************************************************************************[Propagator.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Propagator_h
+#define Minisat_Propagator_h
+
+#include "minisat/core/SolverTypes.h"
+#include "minisat/mtl/Vec.h"
+
+namespace Minisat {
+
+class Solver;
+
+//=================================================================================================
+// Propagator -- interface for constraints that are not represented as clauses:
+//
+// A propagator is called by 'Solver::propagate()' whenever unit propagation over the clauses has
+// reached a fixpoint. It inspects the part of the trail it has not seen yet and either enqueues
+// the literals it implies (through 'enqueue()') or reports a conflict. Implied literals get a lazy
+// reason: the clause justifying them is only asked for (through 'explain()') if conflict analysis
+// actually needs it. Propagators must be complete, i.e. detect every implication and conflict of
+// their constraints as soon as it arises, since the solver will otherwise accept models violating
+// them.
+
+class Propagator
+{
+   public:
+    Propagator(Solver& s) : solver(s), id(-1)
+    {
+    }
+    virtual ~Propagator()
+    {
+    }
+
+    // Propagate the new assignments. Returns FALSE on conflict, in which case 'out_conflict'
+    // holds the literals (all false) of a violated clause implied by the constraints. At least
+    // one of them must belong to the current decision level.
+    virtual bool propagate(vec<Lit>& out_conflict) = 0;
+
+    // Store in 'out_reason' a clause implied by the constraints that propagates 'p', i.e. 'p'
+    // followed by literals that were false when 'p' was enqueued.
+    virtual void explain(Lit p, vec<Lit>& out_reason) = 0;
+
+    // The trail is about to shrink to 'trail_size' assignments.
+    virtual void cancelUntil(int trail_size) = 0;
+
+   protected:
+    Solver& solver;
+
+    lbool value(Var x) const;
+    lbool value(Lit p) const;
+    int level(Var x) const;
+    int decisionLevel() const;
+    const vec<Lit>& trail() const;
+    void enqueue(Lit p); // Enqueue an unassigned literal implied by this propagator.
+
+   private:
+    int id; // Index in the solver's list of propagators.
+    friend class Solver;
+};
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
@@ -19,8 +19,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include <math.h>
+#include <string.h>
 
 #include "minisat/core/Solver.h"
+#include "minisat/core/Card.h"
+#include "minisat/core/Pb.h"
+#include "minisat/core/Walk.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Sort.h"
 #include "minisat/utils/System.h"
@@ -60,6 +64,53 @@ static DoubleOption opt_garbage_frac(
     DoubleRange(0, false, HUGE_VAL, false));
 static IntOption opt_min_learnts_lim(_cat, "min-learnts", "Minimum learnt clause limit", 0,
                                      IntRange(0, INT32_MAX));
+static BoolOption opt_probing(_cat, "probe", "Perform failed literal probing at restarts", false);
+static DoubleOption opt_probe_eff(
+    _cat, "probe-eff", "Propagation effort of probing relative to the propagations of search",
+    0.05, DoubleRange(0, true, 1, true));
+static IntOption opt_probe_int(_cat, "probe-int", "The base number of conflicts between probing",
+                               2000, IntRange(1, INT32_MAX));
+static BoolOption opt_vivify(_cat, "vivify", "Perform clause vivification at restarts", false);
+static DoubleOption opt_vivify_eff(
+    _cat, "vivify-eff",
+    "Propagation effort of vivification relative to the propagations of search", 0.03,
+    DoubleRange(0, true, 1, true));
+static IntOption opt_vivify_int(_cat, "vivify-int",
+                                "The base number of conflicts between vivification", 3000,
+                                IntRange(1, INT32_MAX));
+static BoolOption opt_enum_trail(_cat, "enum-trail",
+                                 "Continue model enumeration from the trail of the last model",
+                                 true);
+static BoolOption opt_reuse_trail(_cat, "reuse-trail",
+                                  "Keep the decisions that would be made again on restarts", true);
+static BoolOption opt_target_phase(_cat, "target-phase",
+                                   "Decide on the phases of the longest conflict-free trail",
+                                   false);
+static IntOption opt_rephase_int(_cat, "rephase-int",
+                                 "The base number of conflicts between rephasing, e.g. 1000 (0 "
+                                 "means never)",
+                                 0, IntRange(0, INT32_MAX));
+static StringOption opt_rephase_seq(_cat, "rephase-seq",
+                                    "The phases to reset to when rephasing, in a cycle "
+                                    "(O=original, I=inverted, B=best, R=random, W=local search)",
+                                    "WOBWIBWRB");
+static IntOption opt_branching(_cat, "branch",
+                               "The decision heuristic (0=VSIDS, 1=LRB, 2=CHB)", 0, IntRange(0, 2));
+static IntOption opt_branch_switch(
+    _cat, "branch-switch",
+    "Conflicts between alternating the decision heuristic with VSIDS (0 means never)", 0,
+    IntRange(0, INT32_MAX));
+static DoubleOption opt_walk_eff(
+    _cat, "walk-eff", "Flips of local search relative to the propagations of search", 0.1,
+    DoubleRange(0, true, HUGE_VAL, false));
+static IntOption opt_walk_int(_cat, "walk-int",
+                              "The base number of conflicts between local search (0 means only "
+                              "as part of rephasing)",
+                              5000, IntRange(0, INT32_MAX));
+static IntOption opt_mem_soft(_cat, "mem-soft",
+                              "Soft limit in megabytes on the clause arena and watch lists, kept "
+                              "by reducing the learnt clauses (0 means none)",
+                              0, IntRange(0, INT32_MAX));
 
 //=================================================================================================
 // Constructor/Destructor:
@@ -81,6 +132,24 @@ Solver::Solver()
       rnd_init_act(opt_rnd_init_act),
       garbage_frac(opt_garbage_frac),
       min_learnts_lim(opt_min_learnts_lim),
+      use_probing(opt_probing),
+      probe_eff(opt_probe_eff),
+      probe_int(opt_probe_int),
+      use_vivify(opt_vivify),
+      vivify_eff(opt_vivify_eff),
+      vivify_int(opt_vivify_int),
+      enum_trail(opt_enum_trail),
+      reuse_trail(opt_reuse_trail),
+      target_phase(opt_target_phase),
+      rephase_int(opt_rephase_int),
+      rephase_seq(opt_rephase_seq),
+      walk_eff(opt_walk_eff),
+      walk_int(opt_walk_int),
+      branching(opt_branching),
+      branch_switch(opt_branch_switch),
+      progress_fd(-1),
+      progress_int(1.0),
+      mem_soft(opt_mem_soft),
       restart_first(opt_restart_first),
       restart_inc(opt_restart_inc)
 
@@ -111,11 +180,41 @@ Solver::Solver()
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      probe_rounds(0),
+      failed_lits(0),
+      probe_units(0),
+      hbr_clauses(0),
+      vivify_rounds(0),
+      vivified_clauses(0),
+      vivify_shrunk(0),
+      vivify_deleted(0),
+      enumerated(0),
+      block_literals(0),
+      batch_queries(0),
+      batch_kept(0),
+      reused_levels(0),
+      rephases(0),
+      walks(0),
+      walk_flips(0),
+      watcher_visits(0),
+      blocker_hits(0),
+      clause_derefs(0),
+      mem_reductions(0),
+      ticks(0)
 
       ,
+      cards(NULL),
+      pbs(NULL),
       watches(WatcherDeleted(ca)),
       order_heap(VarOrderLt(activity)),
+      proj_heap(VarOrderLt(activity)),
+      chb_head(0),
+      lr_step(0.4),
+      branch_alt(opt_branching),
+      next_switch(opt_branch_switch),
+      enum_act(lit_Undef),
+      enum_restarts(0),
       ok(true),
       cla_inc(1),
       var_inc(1),
@@ -124,19 +223,45 @@ Solver::Solver()
       simpDB_props(0),
       progress_estimate(0),
       remove_satisfied(true),
-      next_var(0)
+      next_var(0),
+      probe_round(0),
+      next_probe(0),
+      probe_props(0),
+      next_vivify(0),
+      next_rephase(opt_rephase_int),
+      next_walk(opt_walk_int),
+      walk_props(0),
+      target_assigned(0),
+      best_assigned(0),
+      vivify_props(0)
 
       // Resource constraints:
       //
       ,
       conflict_budget(-1),
       propagation_budget(-1),
-      asynch_interrupt(false)
+      tick_budget(-1),
+      time_budget(0),
+      time_check(0),
+      time_out(false),
+      asynch_interrupt(false),
+      asynch_stats(false),
+      mem_out(false),
+      next_mem_check(0),
+      progress_out(NULL),
+      progress_start(realTime()),
+      progress_last(progress_start),
+      progress_conflicts(0),
+      progress_props(0)
 {
 }
 
 Solver::~Solver()
 {
+    for (int i = 0; i < propagators.size(); i++)
+        delete propagators[i];
+    if (progress_out != NULL)
+        fclose(progress_out);
 }
 
 //=================================================================================================
@@ -158,10 +283,21 @@ Var Solver::newVar(lbool upol, bool dvar)
     watches.init(mkLit(v, true));
     assigns.insert(v, l_Undef);
     vardata.insert(v, mkVarData(CRef_Undef, 0));
+    lazy_owner.insert(v, -1);
     activity.insert(v, rnd_init_act ? drand(random_seed) * 0.00001 : 0);
+    saved_act.insert(v, 0);
+    lr_assigned.insert(v, 0);
+    lr_participated.insert(v, 0);
+    lr_reasoned.insert(v, 0);
+    chb_conflict.insert(v, 0);
     seen.insert(v, 0);
+    probe_stamp.insert(mkLit(v, false), 0);
+    probe_stamp.insert(mkLit(v, true), 0);
     polarity.insert(v, true);
+    target_pol.insert(v, true);
+    best_pol.insert(v, true);
     user_pol.insert(v, upol);
+    projected.insert(v, 0);
     decision.reserve(v);
     trail.capacity(v + 1);
     setDecisionVar(v, dvar);
@@ -209,6 +345,155 @@ bool Solver::addClause_(vec<Lit>& ps)
     return true;
 }
 
+// The literals are a set (duplicates are dropped). Literals true at level 0 lower the bound, false
+// ones are dropped, and a literal together with its negation (exactly one of them is true) lowers
+// the bound by one. Constraints that amount to a clause or to unit clauses are added as such.
+bool Solver::addAtMost_(vec<Lit>& ps, int k)
+{
+    assert(decisionLevel() == 0);
+    if (!ok)
+        return false;
+
+    sort(ps);
+    Lit p;
+    int i, j;
+    for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
+        if (ps[i] != p)
+            ps[j++] = p = ps[i];
+    ps.shrink(i - j);
+
+    // ('~p' follows 'p' in sorted order)
+    for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
+        if (value(ps[i]) == l_True)
+            k--;
+        else if (value(ps[i]) == l_False)
+            continue;
+        else if (ps[i] == ~p)
+            k--, j--, p = lit_Undef;
+        else
+            ps[j++] = p = ps[i];
+    ps.shrink(i - j);
+
+    if (k < 0)
+        return ok = false;
+    else if (k >= ps.size())
+        return true;
+    else if (k == 0) {
+        for (i = 0; i < ps.size(); i++)
+            uncheckedEnqueue(~ps[i]);
+        return ok = (propagate() == CRef_Undef);
+    } else if (k == ps.size() - 1) {
+        for (i = 0; i < ps.size(); i++)
+            ps[i] = ~ps[i];
+        return addClause_(ps);
+    }
+
+    if (cards == NULL)
+        addPropagator(cards = new Card(*this));
+    cards->addAtMost(ps, k);
+    return true;
+}
+
+// At least 'k' of the literals are true iff at most 'n - k' of their negations are.
+bool Solver::addAtLeast_(vec<Lit>& ps, int k)
+{
+    sort(ps);
+    Lit p;
+    int i, j;
+    for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
+        if (ps[i] != p) {
+            p = ps[i];
+            ps[j++] = ~p;
+        }
+    ps.shrink(i - j);
+    return addAtMost_(ps, ps.size() - k);
+}
+
+// The weights are made positive ('w*p' is 'w - w*~p'), terms over the same variable are merged,
+// literals assigned at level 0 are removed and the weights are cut down to the bound. Constraints
+// with equal weights are cardinality constraints, and literals implied at level 0 are assigned.
+bool Solver::addPB_(vec<Lit>& ps, vec<int64_t>& ws, int64_t k)
+{
+    assert(decisionLevel() == 0);
+    assert(ps.size() == ws.size());
+    if (!ok)
+        return false;
+
+    pb_terms.clear();
+    for (int i = 0; i < ps.size(); i++)
+        if (ws[i] > 0)
+            pb_terms.push(PbTerm(ps[i], ws[i]));
+        else if (ws[i] < 0) {
+            pb_terms.push(PbTerm(~ps[i], -ws[i]));
+            k -= ws[i];
+        }
+    sort(pb_terms);
+
+    int i, j;
+    for (i = j = 0; i < pb_terms.size(); i++) {
+        PbTerm t = pb_terms[i];
+        if (value(t.lit) == l_True)
+            k -= t.weight;
+        else if (value(t.lit) == l_False)
+            continue;
+        else if (j > 0 && pb_terms[j - 1].lit == t.lit)
+            pb_terms[j - 1].weight += t.weight;
+        else if (j > 0 && pb_terms[j - 1].lit == ~t.lit) {
+            // 'a*p + b*~p' is 'b + (a - b)*p':
+            PbTerm& u = pb_terms[j - 1];
+            if (u.weight < t.weight)
+                k -= u.weight, u = PbTerm(t.lit, t.weight - u.weight);
+            else
+                k -= t.weight, u.weight -= t.weight;
+            if (u.weight == 0)
+                j--;
+        } else
+            pb_terms[j++] = t;
+    }
+    pb_terms.shrink(i - j);
+
+    if (k <= 0)
+        return true;
+    int64_t sum = 0;
+    for (i = 0; i < pb_terms.size(); i++) {
+        if (pb_terms[i].weight > k)
+            pb_terms[i].weight = k;
+        sum += pb_terms[i].weight;
+    }
+    if (sum < k)
+        return ok = false;
+    sort(pb_terms, PbWeightGt());
+
+    ps.clear();
+    ws.clear();
+    for (i = 0; i < pb_terms.size(); i++) {
+        ps.push(pb_terms[i].lit);
+        ws.push(pb_terms[i].weight);
+    }
+
+    if (ws[0] == ws.last())
+        return addAtLeast_(ps, (int)((k + ws[0] - 1) / ws[0]));
+    else if (ws[0] > sum - k) {
+        for (i = 0; i < ps.size() && ws[i] > sum - k; i++)
+            uncheckedEnqueue(ps[i]);
+        if (propagate() != CRef_Undef)
+            return ok = false;
+        return addPB_(ps, ws, k);
+    }
+
+    if (pbs == NULL)
+        addPropagator(pbs = new Pb(*this));
+    pbs->addPB(ps, ws, k);
+    return true;
+}
+
+void Solver::addPropagator(Propagator* p)
+{
+    assert(decisionLevel() == 0);
+    p->id = propagators.size();
+    propagators.push(p);
+}
+
 void Solver::attachClause(CRef cr)
 {
     const Clause& c = ca[cr];
@@ -265,16 +550,36 @@ bool Solver::satisfied(const Clause& c) const
 void Solver::cancelUntil(int level)
 {
     if (decisionLevel() > level) {
+        for (int i = 0; i < propagators.size(); i++)
+            propagators[i]->cancelUntil(trail_lim[level]);
         for (int c = trail.size() - 1; c >= trail_lim[level]; c--) {
             Var x = var(trail[c]);
             assigns[x] = l_Undef;
             if (phase_saving > 1 || (phase_saving == 1 && c > trail_lim.last()))
                 polarity[x] = sign(trail[c]);
+            if (branching == branch_lrb)
+                lrbUnassign(x);
             insertVarOrder(x);
         }
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        if (chb_head > trail.size())
+            chb_head = trail.size();
+
+        // Free the materialized lazy reasons (and conflicts) that are no longer needed:
+        if (lazy_reasons.size() > 0) {
+            int i, j;
+            for (i = j = 0; i < lazy_reasons.size(); i++) {
+                Clause& c = ca[lazy_reasons[i]];
+                if (value(c[0]) == l_Undef) {
+                    c.mark(1);
+                    ca.free(lazy_reasons[i]);
+                } else
+                    lazy_reasons[j++] = lazy_reasons[i];
+            }
+            lazy_reasons.shrink(i - j);
+        }
     }
 }
 
@@ -285,8 +590,15 @@ Lit Solver::pickBranchLit()
 {
     Var next = var_Undef;
 
+    // Projected variables first (when enumerating models):
+    while (next == var_Undef && !proj_heap.empty()) {
+        next = proj_heap.removeMin();
+        if (value(next) != l_Undef || !decision[next])
+            next = var_Undef;
+    }
+
     // Random decision:
-    if (drand(random_seed) < random_var_freq && !order_heap.empty()) {
+    if (next == var_Undef && drand(random_seed) < random_var_freq && !order_heap.empty()) {
         next = order_heap[irand(random_seed, order_heap.size())];
         if (value(next) == l_Undef && decision[next])
             rnd_decisions++;
@@ -307,6 +619,8 @@ Lit Solver::pickBranchLit()
         return mkLit(next, user_pol[next] == l_True);
     else if (rnd_pol)
         return mkLit(next, drand(random_seed) < 0.5);
+    else if (target_phase)
+        return mkLit(next, target_pol[next]);
     else
         return mkLit(next, polarity[next]);
 }
@@ -330,6 +644,7 @@ Lit Solver::pickBranchLit()
 |________________________________________________________________________________________________@*/
 void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 {
+    MINISAT_PROFILE(prof, analyze);
     int pathC = 0;
     Lit p = lit_Undef;
 
@@ -340,6 +655,8 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 
     do {
         assert(confl != CRef_Undef); // (otherwise should be UIP)
+        if (confl == CRef_Lazy)
+            confl = p == lit_Undef ? explainConflict() : explainLazy(var(p));
         Clause& c = ca[confl];
 
         if (c.learnt())
@@ -349,7 +666,12 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
             Lit q = c[j];
 
             if (!seen[var(q)] && level(var(q)) > 0) {
-                varBumpActivity(var(q));
+                if (branching == branch_vsids)
+                    varBumpActivity(var(q));
+                else if (branching == branch_lrb)
+                    lr_participated[var(q)]++;
+                else
+                    chb_conflict[var(q)] = conflicts;
                 seen[var(q)] = 1;
                 if (level(var(q)) >= decisionLevel())
                     pathC++;
@@ -373,28 +695,31 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     //
     int i, j;
     out_learnt.copyTo(analyze_toclear);
-    if (ccmin_mode == 2) {
-        for (i = j = 1; i < out_learnt.size(); i++)
-            if (reason(var(out_learnt[i])) == CRef_Undef || !litRedundant(out_learnt[i]))
-                out_learnt[j++] = out_learnt[i];
-
-    } else if (ccmin_mode == 1) {
-        for (i = j = 1; i < out_learnt.size(); i++) {
-            Var x = var(out_learnt[i]);
-
-            if (reason(x) == CRef_Undef)
-                out_learnt[j++] = out_learnt[i];
-            else {
-                Clause& c = ca[reason(var(out_learnt[i]))];
-                for (int k = 1; k < c.size(); k++)
-                    if (!seen[var(c[k])] && level(var(c[k])) > 0) {
-                        out_learnt[j++] = out_learnt[i];
-                        break;
-                    }
+    {
+        MINISAT_PROFILE(prof, minimize);
+        if (ccmin_mode == 2) {
+            for (i = j = 1; i < out_learnt.size(); i++)
+                if (reason(var(out_learnt[i])) == CRef_Undef || !litRedundant(out_learnt[i]))
+                    out_learnt[j++] = out_learnt[i];
+
+        } else if (ccmin_mode == 1) {
+            for (i = j = 1; i < out_learnt.size(); i++) {
+                Var x = var(out_learnt[i]);
+
+                if (reason(x) == CRef_Undef)
+                    out_learnt[j++] = out_learnt[i];
+                else {
+                    Clause& c = ca[explain(x)];
+                    for (int k = 1; k < c.size(); k++)
+                        if (!seen[var(c[k])] && level(var(c[k])) > 0) {
+                            out_learnt[j++] = out_learnt[i];
+                            break;
+                        }
+                }
             }
-        }
-    } else
-        i = j = out_learnt.size();
+        } else
+            i = j = out_learnt.size();
+    }
 
     max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
@@ -417,6 +742,21 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         out_btlevel = level(var(p));
     }
 
+    // The reason side rate of LRB: the variables in the reasons of the learnt literals.
+    if (branching == branch_lrb)
+        for (int i = 1; i < out_learnt.size(); i++) {
+            Var x = var(out_learnt[i]);
+            if (reason(x) == CRef_Undef)
+                continue;
+            Clause& c = ca[explain(x)];
+            for (int k = 1; k < c.size(); k++)
+                if (!seen[var(c[k])]) {
+                    seen[var(c[k])] = 1;
+                    analyze_toclear.push(c[k]);
+                    lr_reasoned[var(c[k])]++;
+                }
+        }
+
     for (int j = 0; j < analyze_toclear.size(); j++)
         seen[var(analyze_toclear[j])] = 0; // ('seen[]' is now cleared)
 }
@@ -428,7 +768,7 @@ bool Solver::litRedundant(Lit p)
     assert(seen[var(p)] == seen_undef || seen[var(p)] == seen_source);
     assert(reason(var(p)) != CRef_Undef);
 
-    Clause* c = &ca[reason(var(p))];
+    Clause* c = &ca[explain(var(p))];
     vec<ShrinkStackElem>& stack = analyze_stack;
     stack.clear();
 
@@ -459,7 +799,7 @@ bool Solver::litRedundant(Lit p)
             stack.push(ShrinkStackElem(i, p));
             i = 0;
             p = l;
-            c = &ca[reason(var(p))];
+            c = &ca[explain(var(p))];
         } else {
             // Finished with current element 'p' and reason 'c':
             if (seen[var(p)] == seen_undef) {
@@ -474,7 +814,7 @@ bool Solver::litRedundant(Lit p)
             // Continue with top element on stack:
             i = stack.last().i;
             p = stack.last().l;
-            c = &ca[reason(var(p))];
+            c = &ca[explain(var(p))];
 
             stack.pop();
         }
@@ -509,7 +849,7 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
                 assert(level(x) > 0);
                 out_conflict.insert(~trail[i]);
             } else {
-                Clause& c = ca[reason(x)];
+                Clause& c = ca[explain(x)];
                 for (int j = 1; j < c.size(); j++)
                     if (level(var(c[j])) > 0)
                         seen[var(c[j])] = 1;
@@ -521,12 +861,51 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
     seen[var(p)] = 0;
 }
 
+// Ask the propagator that implied 'x' for its reason, and store it as a clause that lives until 'x'
+// is unassigned. The reason of 'x' is updated accordingly.
+CRef Solver::explainLazy(Var x)
+{
+    assert(reason(x) == CRef_Lazy && value(x) != l_Undef);
+    Lit p = mkLit(x, value(x) == l_False);
+    lazy_tmp.clear();
+    propagators[lazy_owner[x]]->explain(p, lazy_tmp);
+    assert(lazy_tmp.size() > 0 && lazy_tmp[0] == p);
+
+    CRef cr = ca.alloc(lazy_tmp, false);
+    lazy_reasons.push(cr);
+    vardata[x].reason = cr;
+    return cr;
+}
+
+// Store the conflict in 'lazy_conflict' as a clause that lives until the solver backtracks below
+// its highest decision level (the literal of that level is moved first for this reason).
+CRef Solver::explainConflict()
+{
+    assert(lazy_conflict.size() > 0);
+    int max_i = 0;
+    for (int i = 1; i < lazy_conflict.size(); i++)
+        if (level(var(lazy_conflict[i])) > level(var(lazy_conflict[max_i])))
+            max_i = i;
+    Lit p = lazy_conflict[max_i];
+    lazy_conflict[max_i] = lazy_conflict[0];
+    lazy_conflict[0] = p;
+
+    CRef cr = ca.alloc(lazy_conflict, false);
+    lazy_reasons.push(cr);
+    return cr;
+}
+
 void Solver::uncheckedEnqueue(Lit p, CRef from)
 {
     assert(value(p) == l_Undef);
     assigns[var(p)] = lbool(!sign(p));
     vardata[var(p)] = mkVarData(from, decisionLevel());
     trail.push_(p);
+    if (branching == branch_lrb) {
+        lr_assigned[var(p)] = conflicts;
+        lr_participated[var(p)] = 0;
+        lr_reasoned[var(p)] = 0;
+    }
 }
 
 /*_________________________________________________________________________________________________
@@ -535,15 +914,39 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
 |  
 |  Description:
 |    Propagates all enqueued facts. If a conflict arises, the conflicting clause is returned,
-|    otherwise CRef_Undef.
+|    otherwise CRef_Undef. The propagators are run each time the clauses reach a fixpoint; a
+|    conflict found by one of them is returned as CRef_Lazy, with its literals in 'lazy_conflict'
+|    (see 'explainConflict()'). Nothing is allocated in the clause arena.
 |  
 |    Post-conditions:
 |      * the propagation queue is empty, even if there was a conflict.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate()
+{
+    MINISAT_PROFILE(prof, propagate);
+    CRef confl = propagateClauses();
+    if (confl != CRef_Undef || propagators.size() == 0)
+        return confl;
+
+    for (;;) {
+        int trail_before = trail.size();
+        for (int i = 0; i < propagators.size() && trail.size() == trail_before; i++)
+            if (!propagators[i]->propagate(lazy_conflict)) {
+                qhead = trail.size();
+                return CRef_Lazy;
+            }
+
+        if (trail.size() == trail_before || (confl = propagateClauses()) != CRef_Undef)
+            return confl;
+    }
+}
+
+// Unit propagation over the clauses only:
+CRef Solver::propagateClauses()
 {
     CRef confl = CRef_Undef;
     int num_props = 0;
+    uint64_t num_blocked = 0, num_derefs = 0, num_lits = 0;
 
     while (qhead < trail.size()) {
         Lit p = trail[qhead++]; // 'p' is enqueued fact to propagate.
@@ -556,12 +959,14 @@ CRef Solver::propagate()
             Lit blocker = i->blocker;
             if (value(blocker) == l_True) {
                 *j++ = *i++;
+                num_blocked++;
                 continue;
             }
 
             // Make sure the false literal is data[1]:
             CRef cr = i->cref;
             Clause& c = ca[cr];
+            num_derefs++;
             Lit false_lit = ~p;
             if (c[0] == false_lit)
                 c[0] = c[1], c[1] = false_lit;
@@ -582,10 +987,12 @@ CRef Solver::propagate()
                     c[1] = c[k];
                     c[k] = false_lit;
                     watches[~c[1]].push(w);
+                    num_lits += k + 1;
                     goto NextClause;
                 }
 
             // Did not find watch -- clause is unit under assignment:
+            num_lits += c.size();
             *j++ = w;
             if (value(first) == l_False) {
                 confl = cr;
@@ -602,6 +1009,10 @@ CRef Solver::propagate()
     }
     propagations += num_props;
     simpDB_props -= num_props;
+    blocker_hits += num_blocked;
+    clause_derefs += num_derefs;
+    watcher_visits += num_blocked + num_derefs;
+    ticks += num_blocked + num_derefs + num_lits;
 
     return confl;
 }
@@ -612,7 +1023,8 @@ CRef Solver::propagate()
 |  
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
-|    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|    clauses are clauses that are reason to some assignment. Binary clauses are never removed,
+|    except for the hyper-binary resolvents added by probing.
 |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
     ClauseAllocator& ca;
@@ -621,20 +1033,23 @@ struct reduceDB_lt {
     }
     bool operator()(CRef x, CRef y)
     {
-        return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
+        bool kx = ca[x].size() == 2 && !ca[x].hbr(), ky = ca[y].size() == 2 && !ca[y].hbr();
+        return !kx && (ky || ca[x].activity() < ca[y].activity());
     }
 };
 void Solver::reduceDB()
 {
+    MINISAT_PROFILE(prof, reduce);
     int i, j;
     double extra_lim = cla_inc / learnts.size(); // Remove any clause below this activity
 
     sort(learnts, reduceDB_lt(ca));
-    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
-    // and clauses with activity smaller than 'extra_lim':
+    // Don't delete binary (except hyper-binary resolvents) or locked clauses. From the rest, delete
+    // clauses from the first half and clauses with activity smaller than 'extra_lim':
     for (i = j = 0; i < learnts.size(); i++) {
         Clause& c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
+        if ((c.size() > 2 || c.hbr()) && !locked(c) &&
+            (i < learnts.size() / 2 || c.activity() < extra_lim))
             removeClause(learnts[i]);
         else
             learnts[j++] = learnts[i];
@@ -643,6 +1058,72 @@ void Solver::reduceDB()
     checkGarbage();
 }
 
+/*_________________________________________________________________________________________________
+|
+|  memBudget : ()  ->  [void]
+|
+|  Description:
+|    Checked every 1000 conflicts when 'mem_soft' is set. Past the limit, the arena is collected at
+|    once and the watch lists give back their spare capacity. If that does not free a tenth of the
+|    limit, the learnt clauses are reduced, and their limit is lowered to the number left. If at
+|    most a tenth of the limit is still free, 'mem_out' is set and the search stops as if out of
+|    budget (the result is undefined).
+|________________________________________________________________________________________________@*/
+void Solver::memBudget()
+{
+    next_mem_check = conflicts + 1000;
+    double limit = mem_soft * 1024.0 * 1024.0;
+    double target = 0.9 * limit;
+    uint64_t before = memFootprint();
+    if (before <= limit)
+        return;
+
+    garbageCollect();
+    shrinkWatches();
+    if (memFootprint() > target) {
+        mem_reductions++;
+        reduceDB();
+        garbageCollect();
+        shrinkWatches();
+        if (max_learnts > learnts.size())
+            max_learnts = learnts.size();
+    }
+
+    uint64_t after = memFootprint();
+    if (verbosity >= 1)
+        printf("|  Memory reduction:     %12" PRIu64 " bytes => %12" PRIu64
+               " bytes             |\n",
+               before, after);
+    if (after > target) {
+        mem_out = true;
+        if (verbosity >= 1)
+            printf(
+                "|  Soft memory limit exceeded: stopping the search.                           "
+                "|\n");
+    }
+}
+
+uint64_t Solver::memFootprint() const
+{
+    return (uint64_t)ca.capacity() * ClauseAllocator::Unit_Size + watches.bytes();
+}
+
+void Solver::shrinkWatches()
+{
+    watches.cleanAll();
+    for (int v = 0; v < nVars(); v++)
+        for (int s = 0; s < 2; s++) {
+            vec<Watcher>& ws = watches[mkLit(v, s)];
+            if (ws.capacity() <= ws.size() + ws.size() / 2 + 2)
+                continue;
+            vec<Watcher> tmp;
+            tmp.capacity(ws.size());
+            for (int i = 0; i < ws.size(); i++)
+                tmp.push(ws[i]);
+            tmp.moveTo(ws);
+        }
+}
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     int i, j;
@@ -667,12 +1148,56 @@ void Solver::removeSatisfied(vec<CRef>& cs)
 void Solver::rebuildOrderHeap()
 {
     vec<Var> vs;
+    proj_heap.clear();
     for (Var v = 0; v < nVars(); v++)
-        if (decision[v] && value(v) == l_Undef)
-            vs.push(v);
+        if (decision[v] && value(v) == l_Undef) {
+            if (projected[v])
+                proj_heap.insert(v);
+            else
+                vs.push(v);
+        }
     order_heap.build(vs);
 }
 
+// Learning-rate based branching:
+//
+// LRB scores a variable by the rate at which it took part in conflicts (and in the reasons of
+// learnt literals) while it was assigned, CHB by the recency of its last conflict each time it is
+// assigned. Both keep an exponential moving average in 'activity', whose step size decreases from
+// 0.4 to 0.06.
+
+void Solver::chbReward(double mult)
+{
+    for (int i = chb_head; i < trail.size(); i++) {
+        Var v = var(trail[i]);
+        double reward = mult / (conflicts - chb_conflict[v] + 1);
+        varSetActivity(v, (1 - lr_step) * activity[v] + lr_step * reward);
+    }
+    chb_head = trail.size();
+}
+
+// VSIDS and the learning-rate heuristics keep separate scores, which are swapped when switching
+// between them.
+void Solver::setBranching(int b)
+{
+    assert(b >= branch_vsids && b <= branch_chb);
+    if ((b == branch_vsids) != (branching == branch_vsids)) {
+        VMap<double> tmp;
+        activity.moveTo(tmp);
+        saved_act.moveTo(activity);
+        tmp.moveTo(saved_act);
+        rebuildOrderHeap();
+    }
+    if (b == branch_lrb && branching != branch_lrb)
+        for (int i = 0; i < trail.size(); i++) {
+            Var v = var(trail[i]);
+            lr_assigned[v] = conflicts;
+            lr_participated[v] = lr_reasoned[v] = 0;
+        }
+    chb_head = trail.size();
+    branching = b;
+}
+
 /*_________________________________________________________________________________________________
 |
 |  simplify : [void]  ->  [bool]
@@ -683,6 +1208,7 @@ void Solver::rebuildOrderHeap()
 |________________________________________________________________________________________________@*/
 bool Solver::simplify()
 {
+    MINISAT_PROFILE(prof, simplify);
     assert(decisionLevel() == 0);
 
     if (!ok || propagate() != CRef_Undef)
@@ -729,6 +1255,333 @@ bool Solver::simplify()
     return true;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  probe : [void]  ->  [bool]
+|  
+|  Description:
+|    Failed literal probing. Candidates are the literals with outgoing edges in the binary
+|    implication graph: first the roots of the graph, then both polarities of every remaining
+|    variable. Each candidate is propagated at decision level 1, learning the unit '~p' if 'p'
+|    fails, hyper-binary resolvents for literals implied through larger clauses, and the literals
+|    implied by both polarities of a variable as units. Literals implied by an already probed
+|    literal are stamped and not probed again in the same round. The round is limited by a
+|    propagation budget relative to the propagations made by search since the last round.
+|  
+|    Returns FALSE if the clause database was found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::probe()
+{
+    MINISAT_PROFILE(prof, probe);
+    assert(decisionLevel() == 0);
+
+    if (!ok || propagate() != CRef_Undef)
+        return ok = false;
+
+    int64_t budget = (int64_t)((propagations - probe_props) * probe_eff);
+    if (budget < 10000)
+        budget = 10000;
+    uint64_t props_lim = propagations + budget;
+
+    probe_rounds++;
+    probe_round++;
+
+    // Mark literals with outgoing binary implications:
+    vec<char> has_bin(2 * nVars(), 0);
+    for (int k = 0; k < 2; k++) {
+        const vec<CRef>& cs = k == 0 ? clauses : learnts;
+        for (int i = 0; i < cs.size(); i++)
+            if (!isRemoved(cs[i]) && ca[cs[i]].size() == 2) {
+                const Clause& c = ca[cs[i]];
+                has_bin[toInt(~c[0])] = 1;
+                has_bin[toInt(~c[1])] = 1;
+            }
+    }
+
+    // Probing must not disturb the phases saved by search:
+    int saved_phase_saving = phase_saving;
+    phase_saving = 0;
+
+    // Roots of the binary implication graph:
+    for (Var v = 0; v < nVars() && ok && propagations < props_lim && poll(); v++) {
+        for (int s = 0; s < 2; s++) {
+            Lit p = mkLit(v, s);
+            if (has_bin[toInt(p)] && !has_bin[toInt(~p)] && value(p) == l_Undef && decision[v] &&
+                probe_stamp[p] != probe_round && !probeLit(p, probe_implied))
+                break;
+        }
+    }
+
+    // Both polarities of the remaining variables:
+    for (Var v = 0; v < nVars() && ok && propagations < props_lim && poll(); v++) {
+        Lit p = mkLit(v);
+        if (!has_bin[toInt(p)] || !has_bin[toInt(~p)] || value(v) != l_Undef || !decision[v] ||
+            (probe_stamp[p] == probe_round && probe_stamp[~p] == probe_round))
+            continue;
+
+        if (!probeLit(p, probe_implied))
+            continue;
+        vec<Lit> pos_implied;
+        probe_implied.copyTo(pos_implied);
+        for (int i = 0; i < pos_implied.size(); i++)
+            seen[var(pos_implied[i])] = 1 + sign(pos_implied[i]);
+
+        bool neg_ok = probeLit(~p, probe_implied);
+        for (int i = 0; neg_ok && i < probe_implied.size(); i++) {
+            Lit q = probe_implied[i];
+            if (seen[var(q)] == 1 + sign(q) && value(q) == l_Undef) {
+                probe_units++;
+                uncheckedEnqueue(q);
+            }
+        }
+
+        for (int i = 0; i < pos_implied.size(); i++)
+            seen[var(pos_implied[i])] = 0;
+
+        if (neg_ok && propagate() != CRef_Undef)
+            ok = false;
+    }
+
+    phase_saving = saved_phase_saving;
+    probe_props = propagations;
+    next_probe = conflicts + (uint64_t)probe_int * probe_rounds;
+
+    return ok;
+}
+
+// Propagate 'p' at decision level 1. If this fails, '~p' is added as a unit (and propagated),
+// otherwise the literals implied by 'p' are stored in 'implied' and the hyper-binary resolvents
+// found are added as learnt clauses (which 'reduceDB()' may remove, unlike other learnt binaries).
+// Returns FALSE if 'p' failed.
+bool Solver::probeLit(Lit p, vec<Lit>& implied)
+{
+    assert(decisionLevel() == 0);
+    implied.clear();
+
+    newDecisionLevel();
+    uncheckedEnqueue(p);
+    if (propagate() != CRef_Undef) {
+        cancelUntil(0);
+        failed_lits++;
+        uncheckedEnqueue(~p);
+        if (propagate() != CRef_Undef)
+            ok = false;
+        return false;
+    }
+
+    // A literal implied through a clause with at least two antecedents at level 1 is also implied
+    // by 'p' directly:
+    probe_hbr.clear();
+    for (int i = trail_lim[0] + 1; i < trail.size(); i++) {
+        Lit q = trail[i];
+        CRef r = reason(var(q));
+        implied.push(q);
+        probe_stamp[q] = probe_round;
+        if (r != CRef_Undef && r != CRef_Lazy && ca[r].size() > 2) {
+            const Clause& c = ca[r];
+            int n = 0;
+            for (int j = 1; j < c.size() && n < 2; j++)
+                if (level(var(c[j])) > 0)
+                    n++;
+            if (n >= 2)
+                probe_hbr.push(q);
+        }
+    }
+    probe_stamp[p] = probe_round;
+    cancelUntil(0);
+
+    vec<Lit> bin(2);
+    for (int i = 0; i < probe_hbr.size(); i++) {
+        bin[0] = probe_hbr[i];
+        bin[1] = ~p;
+        CRef cr = ca.alloc(bin, true);
+        ca[cr].hbr(true);
+        learnts.push(cr);
+        attachClause(cr);
+        claBumpActivity(ca[cr]);
+        hbr_clauses++;
+    }
+
+    return true;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  vivify : [void]  ->  [bool]
+|  
+|  Description:
+|    Clause vivification. A candidate clause is detached and the negations of its literals are
+|    propagated one by one at decision level 1. Literals found false are dropped; on a conflict,
+|    or when a literal of the clause is found true, the clause is shrunk to the literals whose
+|    negations were actually needed. Learnt clauses implied by the rest of the database are
+|    deleted. Candidates are the learnt clauses not vivified before, most active first, followed
+|    by the problem clauses unless they are owned by a preprocessor ('remove_satisfied' unset).
+|    The round is limited by a propagation budget relative to the propagations made by search
+|    since the last round.
+|  
+|    Returns FALSE if the clause database was found unsatisfiable.
+|________________________________________________________________________________________________@*/
+struct vivify_lt {
+    ClauseAllocator& ca;
+    vivify_lt(ClauseAllocator& ca_) : ca(ca_)
+    {
+    }
+    bool operator()(CRef x, CRef y)
+    {
+        return ca[x].activity() > ca[y].activity();
+    }
+};
+bool Solver::vivify()
+{
+    MINISAT_PROFILE(prof, vivify);
+    assert(decisionLevel() == 0);
+
+    if (!ok || propagate() != CRef_Undef)
+        return ok = false;
+
+    int64_t budget = (int64_t)((propagations - vivify_props) * vivify_eff);
+    if (budget < 10000)
+        budget = 10000;
+    uint64_t props_lim = propagations + budget;
+
+    vivify_rounds++;
+
+    vec<CRef> cands;
+    for (int i = 0; i < learnts.size(); i++) {
+        const Clause& c = ca[learnts[i]];
+        if (!c.vivified() && c.size() > 2)
+            cands.push(learnts[i]);
+    }
+    sort(cands, vivify_lt(ca));
+    if (remove_satisfied)
+        for (int i = 0; i < clauses.size(); i++) {
+            const Clause& c = ca[clauses[i]];
+            if (!c.vivified() && c.size() > 2)
+                cands.push(clauses[i]);
+        }
+
+    // Vivification must not disturb the phases saved by search:
+    int saved_phase_saving = phase_saving;
+    phase_saving = 0;
+
+    for (int i = 0; i < cands.size() && ok && propagations < props_lim && poll(); i++)
+        vivifyClause(cands[i]);
+
+    phase_saving = saved_phase_saving;
+
+    // Forget the clauses removed by vivification:
+    for (int k = 0; k < 2; k++) {
+        vec<CRef>& cs = k == 0 ? learnts : clauses;
+        int i, j;
+        for (i = j = 0; i < cs.size(); i++)
+            if (!isRemoved(cs[i]))
+                cs[j++] = cs[i];
+        cs.shrink(i - j);
+    }
+    checkGarbage();
+
+    vivify_props = propagations;
+    next_vivify = conflicts + (uint64_t)vivify_int * vivify_rounds;
+
+    return ok;
+}
+
+// Vivify a single clause (see 'vivify()'). Returns FALSE if the clause database was found
+// unsatisfiable.
+bool Solver::vivifyClause(CRef cr)
+{
+    assert(decisionLevel() == 0);
+    if (ca[cr].mark() != 0 || satisfied(ca[cr]))
+        return true;
+
+    vivified_clauses++;
+    ca[cr].vivified(true);
+    detachClause(cr, true);
+
+    vivify_lits.clear();
+    CRef confl = CRef_Undef;
+    Lit implied = lit_Undef;
+    newDecisionLevel();
+    for (int i = 0; i < ca[cr].size(); i++) {
+        Lit l = ca[cr][i];
+        if (value(l) == l_True) {
+            implied = l;
+            break;
+        } else if (value(l) == l_Undef) {
+            vivify_lits.push(l);
+            uncheckedEnqueue(~l);
+            if ((confl = propagate()) != CRef_Undef)
+                break;
+        }
+    }
+
+    bool redundant = confl != CRef_Undef || implied != lit_Undef;
+    if (redundant)
+        vivifyAnalyze(confl, implied, vivify_lits);
+    cancelUntil(0);
+    assert(vivify_lits.size() > 0);
+
+    // (not fetched before the analysis, which may allocate the reasons of propagators)
+    Clause& c = ca[cr];
+    if (vivify_lits.size() == c.size()) {
+        if (redundant && c.learnt()) {
+            // Implied by the rest of the database:
+            vivify_deleted++;
+            c.mark(1);
+            ca.free(cr);
+        } else
+            attachClause(cr);
+        return true;
+    }
+
+    vivify_shrunk++;
+    if (vivify_lits.size() == 1) {
+        c.mark(1);
+        ca.free(cr);
+        uncheckedEnqueue(vivify_lits[0]);
+        return ok = propagate() == CRef_Undef;
+    }
+
+    for (int i = 0; i < vivify_lits.size(); i++)
+        c[i] = vivify_lits[i];
+    c.shrink(c.size() - vivify_lits.size());
+    if (c.size() == 2)
+        c.hbr(false); // (not a hyper-binary resolvent, see 'Clause::hbr()')
+    attachClause(cr);
+    return true;
+}
+
+// Store in 'out' the literals of the clause being vivified that are responsible for the conflict
+// 'confl', or, if there is no conflict, for the literal 'p' being true (together with 'p').
+void Solver::vivifyAnalyze(CRef confl, Lit p, vec<Lit>& out)
+{
+    out.clear();
+    if (confl != CRef_Undef) {
+        const Clause& c = ca[confl == CRef_Lazy ? explainConflict() : confl];
+        for (int i = 0; i < c.size(); i++)
+            if (level(var(c[i])) > 0)
+                seen[var(c[i])] = 1;
+    } else {
+        out.push(p);
+        seen[var(p)] = 1;
+    }
+
+    for (int i = trail.size() - 1; i >= trail_lim[0]; i--) {
+        Var x = var(trail[i]);
+        if (seen[x]) {
+            if (reason(x) == CRef_Undef)
+                out.push(~trail[i]);
+            else {
+                const Clause& c = ca[explain(x)];
+                for (int j = 1; j < c.size(); j++)
+                    if (level(var(c[j])) > 0)
+                        seen[var(c[j])] = 1;
+            }
+            seen[x] = 0;
+        }
+    }
+}
+
 /*_________________________________________________________________________________________________
 |
 |  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
@@ -759,8 +1612,13 @@ lbool Solver::search(int nof_conflicts)
             if (decisionLevel() == 0)
                 return l_False;
 
+            if (target_phase || rephase_int > 0)
+                savePhases(trail_lim.last());
+
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
+            if (branching == branch_chb)
+                chbReward(1.0);
             cancelUntil(backtrack_level);
 
             if (learnt_clause.size() == 1) {
@@ -773,9 +1631,15 @@ lbool Solver::search(int nof_conflicts)
                 uncheckedEnqueue(learnt_clause[0], cr);
             }
 
-            varDecayActivity();
+            if (branching == branch_vsids)
+                varDecayActivity();
+            else if (lr_step > 0.06)
+                lr_step -= 1e-6;
             claDecayActivity();
 
+            if (asynch_stats)
+                report();
+
             if (--learntsize_adjust_cnt == 0) {
                 learntsize_adjust_confl *= learntsize_adjust_inc;
                 learntsize_adjust_cnt = (int)learntsize_adjust_confl;
@@ -790,10 +1654,21 @@ lbool Solver::search(int nof_conflicts)
 
         } else {
             // NO CONFLICT
+            if (branching == branch_chb)
+                chbReward(0.9);
+
+            if (mem_soft > 0 && conflicts >= next_mem_check)
+                memBudget();
+
             if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()) {
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
-                cancelUntil(0);
+                cancelUntil(restartLevel());
+                target_assigned = 0;
+                if (branch_switch > 0 && branch_alt != branch_vsids && conflicts >= next_switch) {
+                    setBranching(branching == branch_vsids ? branch_alt : branch_vsids);
+                    next_switch = conflicts + branch_switch;
+                }
                 return l_Undef;
             }
 
@@ -801,6 +1676,22 @@ lbool Solver::search(int nof_conflicts)
             if (decisionLevel() == 0 && !simplify())
                 return l_False;
 
+            // Probe for failed literals:
+            if (decisionLevel() == 0 && use_probing && conflicts >= next_probe && !probe())
+                return l_False;
+
+            // Vivify learnt (and problem) clauses:
+            if (decisionLevel() == 0 && use_vivify && conflicts >= next_vivify && !vivify())
+                return l_False;
+
+            // Reset the phases:
+            if (decisionLevel() == 0 && rephase_int > 0 && conflicts >= next_rephase)
+                rephase();
+
+            // Local search for the phases:
+            if (decisionLevel() == 0 && walk_int > 0 && conflicts >= next_walk)
+                walk();
+
             if (learnts.size() - nAssigns() >= max_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
@@ -838,6 +1729,218 @@ lbool Solver::search(int nof_conflicts)
     }
 }
 
+/*_________________________________________________________________________________________________
+|
+|  restartLevel : ()  ->  [int]
+|
+|  Description:
+|    With 'reuse_trail', a restart only undoes the decision levels that 'pickBranchLit()' would not
+|    redo as they are: the levels of the assumptions are kept, and so is every following level
+|    whose decision would be picked before the best unassigned variable. The search restarts from
+|    level 0 when probing, vivification, rephasing or local search is due, since they only run
+|    there.
+|________________________________________________________________________________________________@*/
+int Solver::restartLevel()
+{
+    if (!reuse_trail || (use_probing && conflicts >= next_probe) ||
+        (use_vivify && conflicts >= next_vivify) ||
+        (rephase_int > 0 && conflicts >= next_rephase) || (walk_int > 0 && conflicts >= next_walk))
+        return 0;
+
+    // The variable 'pickBranchLit()' would decide next without a restart:
+    while (!proj_heap.empty() && (value(proj_heap[0]) != l_Undef || !decision[proj_heap[0]]))
+        proj_heap.removeMin();
+    while (!order_heap.empty() && (value(order_heap[0]) != l_Undef || !decision[order_heap[0]]))
+        order_heap.removeMin();
+    bool next_proj = !proj_heap.empty();
+    Var next = next_proj ? proj_heap[0] : !order_heap.empty() ? order_heap[0] : var_Undef;
+    if (next == var_Undef)
+        return decisionLevel();
+
+    int level = assumptions.size() < decisionLevel() ? assumptions.size() : decisionLevel();
+    for (; level < decisionLevel(); level++) {
+        Var d = var(trail[trail_lim[level]]);
+        bool before = projected[d] ? !next_proj || activity[d] > activity[next]
+                                   : !next_proj && activity[d] > activity[next];
+        if (!before)
+            break;
+    }
+    reused_levels += level;
+    return level;
+}
+
+// Print the statistics requested by 'requestStats()' (e.g. on SIGUSR1).
+void Solver::report()
+{
+    asynch_stats = false;
+    printf("===============================[ Statistics ]==================================\n");
+    printStats();
+    printf("===============================================================================\n");
+    fflush(stdout);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  checkClock : ()  ->  [void]
+|
+|  Description:
+|    Read the clock for 'withinBudget()' and 'poll()', on every 256th call of either. Writes a
+|    progress record if one is due, and sets 'time_out' once past the deadline of
+|    'setTimeBudget()'.
+|________________________________________________________________________________________________@*/
+void Solver::checkClock()
+{
+    double now = realTime();
+    if (progress_fd >= 0 && (progress_out == NULL || now >= progress_last + progress_int))
+        writeProgress(now);
+    if (time_budget > 0 && now >= time_budget)
+        time_out = true;
+    time_check = 256;
+}
+
+// A record is one line of JSON; the rates are over the time since the previous record. The first
+// record is written at the first reading of the clock.
+void Solver::writeProgress(double now)
+{
+    if (progress_out == NULL && (progress_out = fdopen(progress_fd, "w")) == NULL) {
+        progress_fd = -1;
+        return;
+    }
+
+    double elapsed = now - progress_last;
+    fprintf(progress_out,
+            "{\"time\": %.3f, \"conflicts\": %" PRIu64 ", \"conflicts_per_sec\": %.0f"
+            ", \"propagations\": %" PRIu64 ", \"props_per_sec\": %.0f, \"ticks\": %" PRIu64,
+            now - progress_start, conflicts,
+            elapsed > 0 ? (conflicts - progress_conflicts) / elapsed : 0, propagations,
+            elapsed > 0 ? (propagations - progress_props) / elapsed : 0, ticks);
+    fprintf(progress_out,
+            ", \"learnts\": %d, \"learnts_literals\": %" PRIu64 ", \"mem_mb\": %.2f"
+            ", \"trail\": %d, \"level\": %d, \"progress\": %g}\n",
+            nLearnts(), learnts_literals, memUsed(), trail.size(), decisionLevel(),
+            progressEstimate());
+    fflush(progress_out);
+
+    progress_last = now;
+    progress_conflicts = conflicts;
+    progress_props = propagations;
+}
+
+void Solver::savePhases(int assigned)
+{
+    if (assigned > target_assigned) {
+        for (int i = 0; i < assigned; i++)
+            target_pol[var(trail[i])] = sign(trail[i]);
+        target_assigned = assigned;
+    }
+    if (assigned > best_assigned) {
+        for (int i = 0; i < assigned; i++)
+            best_pol[var(trail[i])] = sign(trail[i]);
+        best_assigned = assigned;
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  rephase : ()  ->  [void]
+|
+|  Description:
+|    Reset the saved (and target) phases of all variables to the next kind in 'rephase_seq':
+|    the original phase ('O'), its inverse ('I'), the phases of the longest conflict-free trail
+|    since the last rephasing ('B'), random ones ('R') or the best assignment found by local
+|    search from the current phases ('W'). The intervals grow arithmetically.
+|________________________________________________________________________________________________@*/
+void Solver::rephase()
+{
+    assert(decisionLevel() == 0);
+    int len = strlen(rephase_seq);
+    char kind = len > 0 ? rephase_seq[rephases % len] : 'B';
+    rephases++;
+    next_rephase = conflicts + (uint64_t)rephase_int * rephases;
+
+    if (kind == 'W')
+        walk();
+    for (Var v = 0; v < nVars(); v++) {
+        if (kind == 'O')
+            polarity[v] = true;
+        else if (kind == 'I')
+            polarity[v] = false;
+        else if (kind == 'B')
+            polarity[v] = best_pol[v];
+        else if (kind == 'R')
+            polarity[v] = drand(random_seed) < 0.5;
+        target_pol[v] = polarity[v];
+    }
+    target_assigned = best_assigned = 0;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  walk : ()  ->  [void]
+|
+|  Description:
+|    Run the local search on the problem clauses not satisfied at level 0 (without their false
+|    literals), with the assumptions fixed and starting from the phases the decisions would use,
+|    and make its best assignment the saved (and target) phases. If that assignment satisfies all
+|    clauses (and there are no other constraints), the next descent follows a model and ends
+|    without a conflict, since propagation cannot imply a value the model does not have. Runs at
+|    intervals of 'walk_int' conflicts growing arithmetically, and as the 'W' kind of rephasing.
+|________________________________________________________________________________________________@*/
+void Solver::walk()
+{
+    MINISAT_PROFILE(prof, walk);
+    assert(decisionLevel() == 0);
+    int64_t budget = (int64_t)((propagations - walk_props) * walk_eff);
+    if (budget < 100000)
+        budget = 100000;
+    walks++;
+    next_walk = conflicts + (uint64_t)walk_int * walks;
+
+    // The assumptions are fixed, like the variables assigned at level 0:
+    vec<lbool> fixed(nVars(), l_Undef);
+    for (Var v = 0; v < nVars(); v++)
+        fixed[v] = value(v);
+    for (int i = 0; i < assumptions.size(); i++) {
+        Lit a = assumptions[i];
+        if ((fixed[var(a)] ^ sign(a)) == l_False)
+            return;
+        fixed[var(a)] = lbool(!sign(a));
+    }
+
+    Walk w(*this, nVars());
+    vec<Lit> ps;
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        bool sat = false;
+        ps.clear();
+        for (int j = 0; j < c.size() && !sat; j++)
+            if ((fixed[var(c[j])] ^ sign(c[j])) == l_True)
+                sat = true;
+            else if (fixed[var(c[j])] == l_Undef)
+                ps.push(c[j]);
+        if (sat)
+            continue;
+        else if (ps.size() == 0)
+            return;
+        w.addClause(ps);
+    }
+
+    vec<char> phase(nVars());
+    for (Var v = 0; v < nVars(); v++)
+        phase[v] = fixed[v] != l_Undef ? fixed[v] == l_False
+                   : user_pol[v] != l_Undef ? user_pol[v] == l_True
+                   : target_phase ? target_pol[v]
+                                  : polarity[v];
+    w.run(phase, budget);
+    walk_flips += w.flips;
+    walk_props = propagations;
+
+    for (Var v = 0; v < nVars(); v++)
+        if (fixed[v] == l_Undef)
+            polarity[v] = target_pol[v] = phase[v];
+    target_assigned = 0;
+}
+
 double Solver::progressEstimate() const
 {
     double progress = 0;
@@ -890,6 +1993,7 @@ lbool Solver::solve_()
         return l_False;
 
     solves++;
+    mem_out = false;
 
     max_learnts = nClauses() * learntsize_factor;
     if (max_learnts < min_learnts_lim)
@@ -907,6 +2011,20 @@ lbool Solver::solve_()
     }
 
     // Search:
+    status = solveKeep_();
+
+    if (verbosity >= 1)
+        printf("===============================================================================\n");
+
+    cancelUntil(0);
+    return status;
+}
+
+// NOTE: the search starts from the current trail, whose levels must be the ones of a prefix of
+// 'assumptions' (and the trail is left as it is).
+lbool Solver::solveKeep_()
+{
+    lbool status = l_Undef;
     int curr_restarts = 0;
     while (status == l_Undef) {
         double rest_base =
@@ -917,9 +2035,6 @@ lbool Solver::solve_()
         curr_restarts++;
     }
 
-    if (verbosity >= 1)
-        printf("===============================================================================\n");
-
     if (status == l_True) {
         // Extend & copy model:
         model.growTo(nVars());
@@ -927,8 +2042,130 @@ lbool Solver::solve_()
             model[i] = value(i);
     } else if (status == l_False && conflict.size() == 0)
         ok = false;
+    return status;
+}
 
+//=================================================================================================
+// Model enumeration:
+
+void Solver::startEnum(const vec<Var>& proj, const vec<Lit>& assumps)
+{
+    assert(decisionLevel() == 0 && enum_act == lit_Undef);
+    enum_act = mkLit(newVar(l_Undef, false));
+    assumptions.clear();
+    assumptions.push(enum_act);
+    for (int i = 0; i < assumps.size(); i++)
+        assumptions.push(assumps[i]);
+
+    proj.copyTo(enum_proj);
+    for (int i = 0; i < enum_proj.size(); i++)
+        projected[enum_proj[i]] = 1;
+    rebuildOrderHeap();
+
+    max_learnts = nClauses() * learntsize_factor;
+    if (max_learnts < min_learnts_lim)
+        max_learnts = min_learnts_lim;
+    learntsize_adjust_confl = learntsize_adjust_start_confl;
+    learntsize_adjust_cnt = (int)learntsize_adjust_confl;
+    enum_restarts = 0;
+}
+
+void Solver::stopEnum()
+{
+    assert(enum_act != lit_Undef);
     cancelUntil(0);
+    for (int i = 0; i < enum_proj.size(); i++)
+        projected[enum_proj[i]] = 0;
+    enum_proj.clear();
+    rebuildOrderHeap();
+
+    releaseVar(~enum_act);
+    enum_act = lit_Undef;
+    assumptions.clear();
+}
+
+/*_________________________________________________________________________________________________
+|
+|  blockModel : ()  ->  [void]
+|
+|  Description:
+|    Block the projection of the model on the trail by the negation of its decisions. Projected
+|    variables are decided first, so the decisions up to the highest level of a projected variable
+|    imply the projection and no other decision is needed. The first of them is the activation
+|    literal, which keeps the clause from ever becoming a unit at level 0. With 'enum_trail',
+|    only the top decision level of the clause is undone (the clause then asserts the negation of
+|    its last decision); otherwise the search restarts from level 0.
+|
+|    The second watch of an asserting blocking clause is the activation literal, which stays false
+|    until the next restart: the clause is only visited again if its asserted literal is falsified
+|    (detecting the conflict), instead of every time the search passes through its other decisions.
+|________________________________________________________________________________________________@*/
+void Solver::blockModel()
+{
+    int top = decisionLevel();
+    if (enum_proj.size() > 0) {
+        top = 1;
+        for (int i = 0; i < enum_proj.size(); i++)
+            if (value(enum_proj[i]) != l_Undef && level(enum_proj[i]) > top)
+                top = level(enum_proj[i]);
+    }
+
+    vec<Lit> block;
+    for (int l = top; l > 0; l--) {
+        int beg = trail_lim[l - 1], end = l < decisionLevel() ? trail_lim[l] : trail.size();
+        if (beg < end) // (dummy levels of satisfied assumptions are empty)
+            block.push(~trail[beg]);
+    }
+    assert(block.size() > 0 && block.last() == ~enum_act);
+    block_literals += block.size();
+
+    if (!enum_trail || block.size() == 1) {
+        cancelUntil(0);
+        addClause_(block);
+    } else {
+        cancelUntil(level(var(block[0])) - 1);
+        Lit second = block[1];
+        block[1] = block.last();
+        block.last() = second;
+        CRef cr = ca.alloc(block, false);
+        clauses.push(cr);
+        attachClause(cr);
+        uncheckedEnqueue(block[0], cr);
+    }
+}
+
+// NOTE: assumptions passed in member-variable 'assumptions' (set by 'startEnum()').
+lbool Solver::nextModel()
+{
+    assert(enum_act != lit_Undef);
+    model.clear();
+    conflict.clear();
+    if (!ok)
+        return l_False;
+
+    mem_out = false;
+    lbool status = l_Undef;
+    while (status == l_Undef) {
+        double rest_base =
+            luby_restart ? luby(restart_inc, enum_restarts) : pow(restart_inc, enum_restarts);
+        status = search(rest_base * restart_first);
+        if (!withinBudget())
+            break;
+        if (status == l_Undef)
+            enum_restarts++;
+    }
+
+    if (status == l_True) {
+        enumerated++;
+        model.growTo(nVars());
+        for (int i = 0; i < nVars(); i++)
+            model[i] = value(i);
+        blockModel();
+    } else {
+        if (status == l_False && conflict.size() == 0)
+            ok = false;
+        cancelUntil(0);
+    }
     return status;
 }
 
@@ -958,6 +2195,109 @@ bool Solver::implies(const vec<Lit>& assumps, vec<Lit>& out)
     return ret;
 }
 
+//=================================================================================================
+// Batched solving:
+
+struct batchLit_lt {
+    const vec<int>& freq;
+    bool operator()(Lit x, Lit y) const
+    {
+        return freq[toInt(x)] > freq[toInt(y)] || (freq[toInt(x)] == freq[toInt(y)] && x < y);
+    }
+    batchLit_lt(const vec<int>& f) : freq(f)
+    {
+    }
+};
+
+struct batchQuery_lt {
+    const vec<vec<Lit> >& qs;
+    bool operator()(int x, int y) const
+    {
+        const vec<Lit>& a = qs[x];
+        const vec<Lit>& b = qs[y];
+        for (int i = 0; i < a.size() && i < b.size(); i++)
+            if (a[i] != b[i])
+                return a[i] < b[i];
+        return a.size() < b.size() || (a.size() == b.size() && x < y);
+    }
+    batchQuery_lt(const vec<vec<Lit> >& q) : qs(q)
+    {
+    }
+};
+
+/*_________________________________________________________________________________________________
+|
+|  solveBatch : (batch : const vec<vec<Lit> >&) (status models cores : ...)  ->  [void]
+|
+|  Description:
+|    The order of the assumptions of a query does not matter, so each query is sorted with the
+|    literals assumed most often across the batch first, and the queries are then solved in
+|    lexicographic order. Consecutive queries thus tend to share a prefix of assumptions, and the
+|    levels of that prefix (one per assumption) are kept on the trail from one query to the next.
+|    Learnt clauses are shared by all queries, as with consecutive calls to 'solveLimited()'.
+|________________________________________________________________________________________________@*/
+void Solver::solveBatch(const vec<vec<Lit> >& batch, vec<lbool>& status,
+                        vec<vec<lbool> >& models, vec<vec<Lit> >& cores)
+{
+    status.clear();
+    status.growTo(batch.size(), l_Undef);
+    models.clear();
+    models.growTo(batch.size());
+    cores.clear();
+    cores.growTo(batch.size());
+
+    vec<int> freq(2 * nVars(), 0);
+    vec<vec<Lit> > qs(batch.size());
+    vec<int> order;
+    for (int i = 0; i < batch.size(); i++) {
+        for (int j = 0; j < batch[i].size(); j++)
+            freq[toInt(batch[i][j])]++;
+        batch[i].copyTo(qs[i]);
+        order.push(i);
+    }
+    for (int i = 0; i < qs.size(); i++)
+        sort(qs[i], batchLit_lt(freq));
+    sort(order, batchQuery_lt(qs));
+
+    max_learnts = nClauses() * learntsize_factor;
+    if (max_learnts < min_learnts_lim)
+        max_learnts = min_learnts_lim;
+    learntsize_adjust_confl = learntsize_adjust_start_confl;
+    learntsize_adjust_cnt = (int)learntsize_adjust_confl;
+    mem_out = false;
+
+    cancelUntil(0);
+    assumptions.clear();
+    for (int i = 0; i < order.size() && withinBudget(); i++) {
+        int q = order[i];
+        model.clear();
+        conflict.clear();
+        if (!ok) {
+            status[q] = l_False;
+            continue;
+        }
+
+        // Keep the levels of the assumptions shared with the previous query:
+        int keep = 0;
+        while (keep < qs[q].size() && keep < assumptions.size() &&
+               keep < decisionLevel() && qs[q][keep] == assumptions[keep])
+            keep++;
+        cancelUntil(keep);
+        batch_kept += keep;
+        qs[q].copyTo(assumptions);
+
+        solves++;
+        batch_queries++;
+        status[q] = solveKeep_();
+        if (status[q] == l_True)
+            model.copyTo(models[q]);
+        else if (status[q] == l_False)
+            conflict.toVec().copyTo(cores[q]);
+    }
+    cancelUntil(0);
+    assumptions.clear();
+}
+
 //=================================================================================================
 // Writing CNF to DIMACS:
 //
@@ -1046,13 +2386,161 @@ void Solver::printStats() const
            (float)rnd_decisions * 100 / (float)decisions, decisions / cpu_time);
     printf("propagations          : %-12" PRIu64 "   (%.0f /sec)\n", propagations,
            propagations / cpu_time);
+    printf("ticks                 : %-12" PRIu64 "   (%.0f /sec)\n", ticks, ticks / cpu_time);
     printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", tot_literals,
            (max_literals - tot_literals) * 100 / (double)max_literals);
+    uint64_t total[HwCounters::nevents];
+    if (prof.totalEvents(total)) {
+        printf("hardware events       : %14s %14s %5s %14s %14s\n", "cycles", "instructions",
+               "IPC", "cache misses", "branch misses");
+        printEvents("total", total);
+        for (int i = 0; i < Profile::nphases; i++) {
+            uint64_t ev[HwCounters::nevents];
+            for (int j = 0; j < HwCounters::nevents; j++)
+                ev[j] = prof.events(i, j);
+            if (ev[HwCounters::cycles] > 0)
+                printEvents(Profile::name(i), ev);
+        }
+    }
+    if (verbosity >= 2) {
+        vec<MemUse> mem;
+        memUse(mem);
+        uint64_t total = 0;
+        for (int i = 0; i < mem.size(); i++)
+            total += mem[i].bytes;
+        printf("memory by structure   : %.2f MB\n", total / (1024.0 * 1024.0));
+        for (int i = 0; i < mem.size(); i++)
+            printf("  %-20s: %12.2f MB\n", mem[i].name, mem[i].bytes / (1024.0 * 1024.0));
+    }
+    if (mem_soft > 0)
+        printf("memory reductions     : %-12" PRIu64 "%s\n", mem_reductions,
+               mem_out ? "   (soft limit exceeded)" : "");
     if (mem_used != 0)
         printf("Memory used           : %.2f MB\n", mem_used);
     printf("CPU time              : %g s\n", cpu_time);
 }
 
+void Solver::printEvents(const char* name, const uint64_t* ev)
+{
+    uint64_t cyc = ev[HwCounters::cycles], ins = ev[HwCounters::instructions];
+    printf("  %-20s: %14" PRIu64 " %14" PRIu64 " %5.2f %14" PRIu64 " %14" PRIu64 "\n", name, cyc,
+           ins, cyc == 0 ? 0 : (double)ins / cyc, ev[HwCounters::cache_misses],
+           ev[HwCounters::branch_misses]);
+}
+
+void Solver::printStatsJson(FILE* f) const
+{
+    fprintf(f, "{");
+    statsJson(f);
+    fprintf(f, "}\n");
+}
+
+void Solver::statsJson(FILE* f) const
+{
+    fprintf(f, "\"vars\": %d, \"clauses\": %d, \"learnts\": %d", nVars(), nClauses(),
+            nLearnts());
+    fprintf(f, ", \"solves\": %" PRIu64 ", \"restarts\": %" PRIu64 ", \"conflicts\": %" PRIu64,
+            solves, starts, conflicts);
+    fprintf(f, ", \"decisions\": %" PRIu64 ", \"rnd_decisions\": %" PRIu64, decisions,
+            rnd_decisions);
+    fprintf(f, ", \"propagations\": %" PRIu64 ", \"watcher_visits\": %" PRIu64, propagations,
+            watcher_visits);
+    fprintf(f, ", \"blocker_hits\": %" PRIu64 ", \"clause_derefs\": %" PRIu64, blocker_hits,
+            clause_derefs);
+    fprintf(f, ", \"ticks\": %" PRIu64, ticks);
+    fprintf(f, ", \"conflict_literals\": %" PRIu64 ", \"deleted_literals\": %" PRIu64,
+            tot_literals, max_literals - tot_literals);
+    fprintf(f, ", \"probe_rounds\": %" PRIu64 ", \"failed_lits\": %" PRIu64, probe_rounds,
+            failed_lits);
+    fprintf(f, ", \"vivified_clauses\": %" PRIu64 ", \"rephases\": %" PRIu64, vivified_clauses,
+            rephases);
+    fprintf(f, ", \"walk_flips\": %" PRIu64 ", \"reused_levels\": %" PRIu64, walk_flips,
+            reused_levels);
+    fprintf(f, ", \"mem_reductions\": %" PRIu64 ", \"mem_out\": %s", mem_reductions,
+            mem_out ? "true" : "false");
+    fprintf(f, ", \"mem_peak_mb\": %.2f, \"cpu_time\": %g", memUsedPeak(), cpuTime());
+
+    fprintf(f, ", \"phases\": {");
+    for (int i = 0; Profile::enabled() && i < Profile::nphases; i++) {
+        fprintf(f, "%s\"%s\": {\"calls\": %" PRIu64 ", \"seconds\": %g", i == 0 ? "" : ", ",
+                Profile::name(i), prof.calls(i), prof.seconds(i));
+        for (int j = 0; prof.hwEnabled() && j < HwCounters::nevents; j++)
+            fprintf(f, ", \"%s\": %" PRIu64, HwCounters::name(j), prof.events(i, j));
+        fprintf(f, "}");
+    }
+    fprintf(f, "}");
+
+    uint64_t total[HwCounters::nevents];
+    if (prof.totalEvents(total)) {
+        fprintf(f, ", \"hw_events\": {");
+        for (int j = 0; j < HwCounters::nevents; j++)
+            fprintf(f, "%s\"%s\": %" PRIu64, j == 0 ? "" : ", ", HwCounters::name(j), total[j]);
+        fprintf(f, "}");
+    }
+
+    vec<MemUse> mem;
+    memUse(mem);
+    fprintf(f, ", \"memory\": {");
+    for (int i = 0; i < mem.size(); i++)
+        fprintf(f, "%s\"%s\": %" PRIu64, i == 0 ? "" : ", ", mem[i].name, mem[i].bytes);
+    fprintf(f, "}");
+}
+
+void Solver::addMemUse(vec<MemUse>& out, const char* name, uint64_t bytes)
+{
+    out.push();
+    out.last().name = name;
+    out.last().bytes = bytes;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  memUse : (out : vec<MemUse>&)  ->  [void]
+|
+|  Description:
+|    Append the bytes held by each main structure to 'out', spare capacity included. The clause
+|    arena is split into the words of the original and learnt clauses, the other live clauses
+|    (lazy reasons and clauses held by propagators), the words freed but not yet collected, and
+|    the capacity not yet used.
+|________________________________________________________________________________________________@*/
+void Solver::memUse(vec<MemUse>& out) const
+{
+    uint64_t orig = 0, lrnt = 0;
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        orig += ClauseAllocator::clauseWord32Size(c.size(), c.has_extra());
+    }
+    for (int i = 0; i < learnts.size(); i++) {
+        const Clause& c = ca[learnts[i]];
+        lrnt += ClauseAllocator::clauseWord32Size(c.size(), c.has_extra());
+    }
+    uint64_t live = ca.size() - ca.wasted();
+    uint64_t other = live > orig + lrnt ? live - orig - lrnt : 0;
+    addMemUse(out, "arena_original", orig * ClauseAllocator::Unit_Size);
+    addMemUse(out, "arena_learnt", lrnt * ClauseAllocator::Unit_Size);
+    addMemUse(out, "arena_other", other * ClauseAllocator::Unit_Size);
+    addMemUse(out, "arena_wasted", (uint64_t)ca.wasted() * ClauseAllocator::Unit_Size);
+    addMemUse(out, "arena_slack",
+              (uint64_t)(ca.capacity() - ca.size()) * ClauseAllocator::Unit_Size);
+
+    uint64_t ws_used = 0, ws_total = watches.bytes();
+    for (int v = 0; v < nVars(); v++)
+        for (int s = 0; s < 2; s++)
+            ws_used += (uint64_t)watches[mkLit(v, s)].size() * sizeof(Watcher);
+    addMemUse(out, "watches", ws_used);
+    addMemUse(out, "watches_slack", ws_total - ws_used);
+
+    addMemUse(out, "var_arrays",
+              bytes(activity) + bytes(assigns) + bytes(polarity) + bytes(user_pol) +
+                  bytes(decision) + bytes(vardata) + bytes(saved_act) + bytes(lr_assigned) +
+                  bytes(lr_participated) + bytes(lr_reasoned) + bytes(chb_conflict) +
+                  bytes(projected) + bytes(seen) + bytes(target_pol) + bytes(best_pol) +
+                  bytes(lazy_owner) + bytes(probe_stamp) + bytes(model));
+    addMemUse(out, "trail", bytes(trail) + bytes(trail_lim) + bytes(assumptions));
+    addMemUse(out, "clause_lists", bytes(clauses) + bytes(learnts) + bytes(lazy_reasons));
+    addMemUse(out, "order_heap", order_heap.bytes() + proj_heap.bytes());
+}
+
 //=================================================================================================
 // Garbage Collection methods:
 
@@ -1076,12 +2564,18 @@ void Solver::relocAll(ClauseAllocator& to)
 
         // Note: it is not safe to call 'locked()' on a relocated clause. This is why we keep
         // 'dangling' reasons here. It is safe and does not hurt.
-        if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)]))) {
+        if (reason(v) != CRef_Undef && reason(v) != CRef_Lazy &&
+            (ca[reason(v)].reloced() || locked(ca[reason(v)]))) {
             assert(!isRemoved(reason(v)));
             ca.reloc(vardata[v].reason, to);
         }
     }
 
+    // All materialized lazy reasons:
+    //
+    for (int i = 0; i < lazy_reasons.size(); i++)
+        ca.reloc(lazy_reasons[i], to);
+
     // All learnt:
     //
     int i, j;
@@ -1104,6 +2598,7 @@ void Solver::relocAll(ClauseAllocator& to)
 
 void Solver::garbageCollect()
 {
+    MINISAT_PROFILE(prof, gc);
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
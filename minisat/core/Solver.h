@@ -21,15 +21,21 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Solver_h
 #define Minisat_Solver_h
 
+#include "minisat/core/Propagator.h"
 #include "minisat/core/SolverTypes.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Heap.h"
 #include "minisat/mtl/IntMap.h"
 #include "minisat/mtl/Vec.h"
 #include "minisat/utils/Options.h"
+#include "minisat/utils/Profile.h"
+#include "minisat/utils/System.h"
 
 namespace Minisat {
 
+class Card;
+class Pb;
+
 //=================================================================================================
 // Solver -- the main class:
 
@@ -56,6 +62,15 @@ class Solver
     bool addClause_(
         vec<Lit>& ps); // Add a clause to the solver without making superflous internal copy. Will
                        // change the passed vector 'ps'.
+    bool addAtMost(const vec<Lit>& ps, int k);  // Add the constraint 'at most k of ps are true'.
+    bool addAtLeast(const vec<Lit>& ps, int k); // Add the constraint 'at least k of ps are true'.
+    bool addAtMost_(vec<Lit>& ps, int k);       // Like 'addClause_()'. Duplicate literals count once.
+    bool addAtLeast_(vec<Lit>& ps, int k);      // Like 'addClause_()'. Duplicate literals count once.
+    bool addPB(const vec<Lit>& ps, const vec<int64_t>& ws,
+               int64_t k); // Add the constraint 'ws[0]*ps[0] + ... + ws[n-1]*ps[n-1] >= k'.
+    bool addPB_(vec<Lit>& ps, vec<int64_t>& ws, int64_t k); // Like 'addClause_()'.
+    void addPropagator(
+        Propagator* p); // Add a propagator for non-clausal constraints (the solver takes ownership).
 
     // Solving:
     //
@@ -73,6 +88,28 @@ class Solver
 
     bool implies(const vec<Lit>& assumps, vec<Lit>& out);
 
+    // Model enumeration: (the trail is kept between calls to 'nextModel()', so the solver may not
+    // be used otherwise until 'stopEnum()')
+    //
+    void startEnum(const vec<Var>& proj,
+                   const vec<Lit>& assumps); // Enumerate the models under 'assumps', projected
+                                             // onto 'proj' (all variables if empty).
+    void startEnum(const vec<Var>& proj);
+    lbool nextModel(); // Find a model that differs from all earlier ones on the projection. Returns
+                       // l_False when there are no more, and l_Undef if the budget ran out.
+    void stopEnum();   // End the enumeration, dropping its blocking clauses.
+
+    // Batched solving: (queries that differ only in their assumptions; the assignments of the
+    // assumptions shared with the previous query are kept instead of being propagated again. Not
+    // for a 'SimpSolver' whose assumption variables may be eliminated)
+    //
+    void solveBatch(const vec<vec<Lit> >& batch, vec<lbool>& status, vec<vec<lbool> >& models,
+                    vec<vec<Lit> >& cores); // Solve under each set of assumptions in 'batch' as
+                                            // 'solveLimited()' would. The model of satisfiable
+                                            // queries and the 'conflict' of unsatisfiable ones are
+                                            // stored at the same index ('l_Undef' queries were cut
+                                            // short by the budget).
+
     // Iterate over clauses and top-level assignments:
     ClauseIterator clausesBegin() const;
     ClauseIterator clausesEnd() const;
@@ -99,6 +136,7 @@ class Solver
         Var v,
         bool
             b); // Declare if a variable should be eligible for selection in the decision heuristic.
+    void setBranching(int b); // Switch the decision heuristic (see 'branching').
 
     // Read state:
     //
@@ -114,14 +152,27 @@ class Solver
     int nVars() const;    // The current number of variables.
     int nFreeVars() const;
     void printStats() const; // Print some current statistics to standard output.
+    void printStatsJson(FILE* f) const; // Write the statistics and phase times as a JSON object.
+
+    // Memory accounting:
+    //
+    struct MemUse {
+        const char* name;
+        uint64_t bytes;
+    };
+    virtual void memUse(vec<MemUse>& out) const; // The bytes allocated by each main structure
+                                                 // (including spare capacity).
 
     // Resource contraints:
     //
     void setConfBudget(int64_t x);
     void setPropBudget(int64_t x);
+    void setTickBudget(int64_t x);    // Limit the search to 'x' more ticks (see 'ticks').
+    void setTimeBudget(double secs); // Limit the search to 'secs' more wall-clock seconds.
     void budgetOff();
     void interrupt();      // Trigger a (potentially asynchronous) interruption of the solver.
     void clearInterrupt(); // Clear interrupt indicator flag.
+    void requestStats();   // Print the statistics at the next conflict (safe in signal handlers).
 
     // Memory managment:
     //
@@ -150,6 +201,24 @@ class Solver
     double
         garbage_frac; // The fraction of wasted memory allowed before a garbage collection is triggered.
     int min_learnts_lim; // Minimum number to set the learnts limit to.
+    bool use_probing;    // Perform failed literal probing at restarts.
+    double probe_eff;    // Propagations spent on probing relative to propagations spent on search.
+    int probe_int;       // The base number of conflicts between probing rounds.
+    bool use_vivify;     // Perform clause vivification at restarts.
+    double vivify_eff;   // Propagations spent on vivification relative to propagations spent on search.
+    int vivify_int;      // The base number of conflicts between vivification rounds.
+    bool enum_trail;     // Continue model enumeration from the trail instead of restarting.
+    bool reuse_trail;    // Keep the decisions that would be made again on restarts.
+    bool target_phase;   // Decide on the phases of the longest conflict-free trail of the restart.
+    int rephase_int;     // The base number of conflicts between rephasing (0 means never).
+    const char* rephase_seq; // The phases to reset to when rephasing, in a cycle (see 'rephase()').
+    double walk_eff;     // Flips of local search relative to the propagations of search.
+    int walk_int;        // The base number of conflicts between local search (0 means only 'W').
+    int branching;       // The decision heuristic (0=VSIDS, 1=LRB, 2=CHB); see 'setBranching()'.
+    int branch_switch;   // Conflicts between alternating the heuristic with VSIDS (0 means never).
+    int progress_fd;     // Write JSON progress records to this file descriptor (-1 means none).
+    double progress_int; // Wall-clock seconds between progress records.
+    int mem_soft; // Soft limit in megabytes on the clause arena and watch lists (0 means none).
 
     int restart_first; // The initial restart limit.                                                                (default 100)
     double
@@ -167,6 +236,16 @@ class Solver
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
     uint64_t dec_vars, num_clauses, num_learnts, clauses_literals, learnts_literals, max_literals,
         tot_literals;
+    uint64_t probe_rounds, failed_lits, probe_units, hbr_clauses;
+    uint64_t vivify_rounds, vivified_clauses, vivify_shrunk, vivify_deleted;
+    uint64_t enumerated, block_literals;
+    uint64_t batch_queries, batch_kept; // (assumption levels kept between queries)
+    uint64_t reused_levels;             // (decision levels kept on restarts)
+    uint64_t rephases, walks, walk_flips;
+    uint64_t watcher_visits, blocker_hits, clause_derefs; // (in the clause propagation loop)
+    uint64_t mem_reductions; // (learnt clause reductions forced by 'mem_soft')
+    uint64_t ticks; // (watcher visits plus clause literal accesses, a machine independent time)
+    Profile prof;                                         // (time spent in each phase)
 
    protected:
     // Helper structures:
@@ -219,6 +298,28 @@ class Solver
         }
     };
 
+    struct PbTerm {
+        Lit lit;
+        int64_t weight;
+        PbTerm()
+        {
+        }
+        PbTerm(Lit l, int64_t w) : lit(l), weight(w)
+        {
+        }
+        bool operator<(const PbTerm& t) const
+        {
+            return lit < t.lit;
+        }
+    };
+
+    struct PbWeightGt {
+        bool operator()(const PbTerm& x, const PbTerm& y) const
+        {
+            return x.weight > y.weight;
+        }
+    };
+
     struct ShrinkStackElem {
         uint32_t i;
         Lit l;
@@ -234,6 +335,11 @@ class Solver
     vec<Lit> trail;     // Assignment stack; stores all assigments made in the order they were made.
     vec<int> trail_lim; // Separator indices for different decision levels in 'trail'.
     vec<Lit> assumptions; // Current set of assumptions provided to solve by the user.
+    vec<Propagator*> propagators; // Propagators for non-clausal constraints (owned by the solver).
+    VMap<int> lazy_owner;   // The propagator that implied a variable with reason 'CRef_Lazy'.
+    vec<CRef> lazy_reasons; // Clauses materialized from lazy reasons and conflicts.
+    Card* cards;            // The propagator of cardinality constraints (created on demand).
+    Pb* pbs;                // The propagator of pseudo-Boolean constraints (created on demand).
 
     VMap<double> activity; // A heuristic measurement of the activity of a variable.
     VMap<lbool> assigns;   // The current assignments.
@@ -247,6 +353,24 @@ class Solver
 
     Heap<Var, VarOrderLt>
         order_heap; // A priority queue of variables ordered with respect to the variable activity.
+    Heap<Var, VarOrderLt> proj_heap; // The same for projected variables, which are decided first.
+
+    // Learning-rate based branching: ('activity' holds the scores of the heuristic in use)
+    //
+    enum { branch_vsids = 0, branch_lrb = 1, branch_chb = 2 };
+    VMap<double> saved_act;         // The scores of VSIDS or of the learning-rate heuristics.
+    VMap<uint64_t> lr_assigned;     // (LRB) The value of 'conflicts' when a variable was assigned, ...
+    VMap<uint32_t> lr_participated; // ... the conflicts it took part in since, ...
+    VMap<uint32_t> lr_reasoned;     // ... and the reasons of learnt literals it was in.
+    VMap<uint64_t> chb_conflict;    // (CHB) The last conflict a variable took part in.
+    int chb_head;                   // (CHB) The start of the trail not yet rewarded.
+    double lr_step;                 // The step size of both (decreasing with each conflict).
+    int branch_alt;                 // The heuristic alternated with VSIDS by 'branch_switch'.
+    uint64_t next_switch;           // Number of conflicts at which the heuristic is switched next.
+    VMap<char> projected;            // The variables of the projection of the current enumeration.
+    vec<Var> enum_proj;              // ... and as a list.
+    Lit enum_act;      // Assumed first during enumeration; the blocking clauses contain its negation.
+    int enum_restarts; // The number of restarts of the current enumeration.
 
     bool
         ok; // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
@@ -272,6 +396,28 @@ class Solver
     vec<ShrinkStackElem> analyze_stack;
     vec<Lit> analyze_toclear;
     vec<Lit> add_tmp;
+    vec<int64_t> add_weights;
+    vec<PbTerm> pb_terms;
+    vec<Lit> probe_implied;
+    vec<Lit> probe_hbr;
+    vec<Lit> vivify_lits;
+    vec<Lit> lazy_conflict;
+    vec<Lit> lazy_tmp;
+
+    LMap<uint32_t> probe_stamp; // The last probing round in which a literal was implied.
+    uint32_t probe_round;       // Current probing round (stamp value).
+    uint64_t next_probe;        // Number of conflicts at which the next probing round is allowed.
+    uint64_t probe_props;       // Value of 'propagations' at the end of the last probing round.
+    uint64_t next_vivify;       // Number of conflicts at which the next vivification round is allowed.
+    uint64_t next_rephase;      // Number of conflicts at which the phases are reset next.
+    uint64_t next_walk;         // Number of conflicts at which the next local search is due.
+    uint64_t walk_props;        // Value of 'propagations' at the end of the last local search.
+
+    VMap<char> target_pol; // The phases of the longest conflict-free trail since the last restart, ...
+    VMap<char> best_pol;   // ... and since the last rephasing.
+    int target_assigned;   // The length of the trail saved in 'target_pol', ...
+    int best_assigned;     // ... and in 'best_pol'.
+    uint64_t vivify_props;      // Value of 'propagations' at the end of the last vivification round.
 
     double max_learnts;
     double learntsize_adjust_confl;
@@ -281,7 +427,22 @@ class Solver
     //
     int64_t conflict_budget;    // -1 means no budget.
     int64_t propagation_budget; // -1 means no budget.
+    int64_t tick_budget;        // -1 means no budget.
+    double time_budget;         // Wall-clock deadline (as given by 'realTime()'), 0 means none.
+    int time_check;             // Calls of 'withinBudget()'/'poll()' before the clock is read.
+    bool time_out;              // Set once the clock was read past 'time_budget'.
     bool asynch_interrupt;
+    bool asynch_stats;
+    bool mem_out;            // Set when the soft memory limit can't be kept (until the next solve).
+    uint64_t next_mem_check; // Number of conflicts at which the memory is checked next.
+
+    // Progress records:
+    //
+    FILE* progress_out;           // (opened on 'progress_fd' by the first record)
+    double progress_start;        // Wall-clock time at construction, ...
+    double progress_last;         // ... and of the last record.
+    uint64_t progress_conflicts;  // The conflicts and ...
+    uint64_t progress_props;      // ... propagations at the last record.
 
     // Main internal methods:
     //
@@ -294,6 +455,10 @@ class Solver
         Lit p,
         CRef from = CRef_Undef); // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef propagate();            // Perform unit propagation. Returns possibly conflicting clause.
+    CRef propagateClauses();     // (helper method for 'propagate()')
+    CRef explain(Var x);         // The reason of 'x' as a clause (materializing a lazy reason).
+    CRef explainLazy(Var x);     // (helper method for 'explain()')
+    CRef explainConflict();      // The conflict reported by a propagator as a clause.
     void cancelUntil(int level); // Backtrack until a certain level.
     void analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel); // (bt = backtrack)
     void analyzeFinal(
@@ -302,10 +467,27 @@ class Solver
             out_conflict); // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool litRedundant(Lit p);            // (helper method for 'analyze()')
     lbool search(int nof_conflicts);     // Search for a given number of conflicts.
+    int restartLevel();                  // The level to backtrack to on a restart.
+    void report();                       // Print the requested statistics.
+    void checkClock();                   // (helper method for 'withinBudget()' and 'poll()')
+    void writeProgress(double now);      // Write a progress record to 'progress_fd'.
+    void savePhases(int assigned); // Save the first 'assigned' literals of the trail as target/best.
+    void rephase();                // Reset the phases (at level 0).
+    void walk();                   // Local search from the current phases (at level 0).
     lbool solve_();                      // Main solve method (assumptions given in 'assumptions').
+    lbool solveKeep_(); // Like 'solve_()', but keeps the trail (used by 'solveBatch()').
+    void blockModel();                   // Add a clause excluding the projection of the current model.
     void reduceDB();                     // Reduce the set of learnt clauses.
     void removeSatisfied(vec<CRef>& cs); // Shrink 'cs' to contain only non-satisfied clauses.
     void rebuildOrderHeap();
+    uint64_t memFootprint() const; // The bytes held by the clause arena and the watch lists.
+    void memBudget();              // Free memory if over 'mem_soft' (sets 'mem_out' if it can't).
+    void shrinkWatches();          // Release the spare capacity of the watch lists.
+    bool probe();                              // Failed literal probing (at level 0).
+    bool probeLit(Lit p, vec<Lit>& implied);   // (helper method for 'probe()')
+    bool vivify();                             // Clause vivification (at level 0).
+    bool vivifyClause(CRef cr);                // (helper method for 'vivify()')
+    void vivifyAnalyze(CRef confl, Lit p, vec<Lit>& out); // (helper method for 'vivify()')
 
     // Maintaining Variable/Clause activity:
     //
@@ -316,6 +498,9 @@ class Solver
     void
     claDecayActivity(); // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
     void claBumpActivity(Clause& c); // Increase a clause with the current 'bump' value.
+    void varSetActivity(Var v, double a); // Set the score of a variable (learning-rate heuristics).
+    void lrbUnassign(Var v);              // (LRB) Update the score of a variable being unassigned.
+    void chbReward(double mult);          // (CHB) Reward the variables assigned since 'chb_head'.
 
     // Operations on clauses:
     //
@@ -336,8 +521,22 @@ class Solver
     CRef reason(Var x) const;
     int level(Var x) const;
     double progressEstimate() const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
-    bool withinBudget() const;
+    bool withinBudget();
+    bool poll(); // Called in the loops of the long phases without conflicts (see below).
     void relocAll(ClauseAllocator& to);
+    virtual void statsJson(FILE* f) const; // Write the members of the 'printStatsJson()' object.
+    static void printEvents(const char* name, const uint64_t* ev); // (a line of 'printStats()')
+    static void addMemUse(vec<MemUse>& out, const char* name, uint64_t bytes);
+    template <class T>
+    static uint64_t bytes(const vec<T>& v)
+    {
+        return (uint64_t)v.capacity() * sizeof(T);
+    }
+    template <class K, class V, class MkIndex>
+    static uint64_t bytes(const IntMap<K, V, MkIndex>& m)
+    {
+        return (uint64_t)m.capacity() * sizeof(V);
+    }
 
     // Static helpers:
     //
@@ -356,6 +555,9 @@ class Solver
     {
         return (int)(drand(seed) * size);
     }
+
+    friend class Propagator;
+    friend class Walk;
 };
 
 //=================================================================================================
@@ -365,6 +567,10 @@ inline CRef Solver::reason(Var x) const
 {
     return vardata[x].reason;
 }
+inline CRef Solver::explain(Var x)
+{
+    return reason(x) == CRef_Lazy ? explainLazy(x) : reason(x);
+}
 inline int Solver::level(Var x) const
 {
     return vardata[x].level;
@@ -372,8 +578,9 @@ inline int Solver::level(Var x) const
 
 inline void Solver::insertVarOrder(Var x)
 {
-    if (!order_heap.inHeap(x) && decision[x])
-        order_heap.insert(x);
+    Heap<Var, VarOrderLt>& heap = projected[x] ? proj_heap : order_heap;
+    if (!heap.inHeap(x) && decision[x])
+        heap.insert(x);
 }
 
 inline void Solver::varDecayActivity()
@@ -396,6 +603,26 @@ inline void Solver::varBumpActivity(Var v, double inc)
     // Update order_heap with respect to new activity:
     if (order_heap.inHeap(v))
         order_heap.decrease(v);
+    else if (proj_heap.inHeap(v))
+        proj_heap.decrease(v);
+}
+
+inline void Solver::varSetActivity(Var v, double a)
+{
+    activity[v] = a;
+    if (order_heap.inHeap(v))
+        order_heap.update(v);
+    else if (proj_heap.inHeap(v))
+        proj_heap.update(v);
+}
+
+inline void Solver::lrbUnassign(Var v)
+{
+    uint64_t interval = conflicts - lr_assigned[v];
+    if (interval > 0) {
+        double rate = (double)(lr_participated[v] + lr_reasoned[v]) / interval;
+        varSetActivity(v, (1 - lr_step) * activity[v] + lr_step * rate);
+    }
 }
 
 inline void Solver::claDecayActivity()
@@ -467,6 +694,22 @@ inline bool Solver::addClause(Lit p, Lit q, Lit r, Lit s)
     add_tmp.push(s);
     return addClause_(add_tmp);
 }
+inline bool Solver::addAtMost(const vec<Lit>& ps, int k)
+{
+    ps.copyTo(add_tmp);
+    return addAtMost_(add_tmp, k);
+}
+inline bool Solver::addAtLeast(const vec<Lit>& ps, int k)
+{
+    ps.copyTo(add_tmp);
+    return addAtLeast_(add_tmp, k);
+}
+inline bool Solver::addPB(const vec<Lit>& ps, const vec<int64_t>& ws, int64_t k)
+{
+    ps.copyTo(add_tmp);
+    ws.copyTo(add_weights);
+    return addPB_(add_tmp, add_weights, k);
+}
 
 inline bool Solver::isRemoved(CRef cr) const
 {
@@ -475,7 +718,7 @@ inline bool Solver::isRemoved(CRef cr) const
 inline bool Solver::locked(const Clause& c) const
 {
     return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef &&
-           ca.lea(reason(var(c[0]))) == &c;
+           reason(var(c[0])) != CRef_Lazy && ca.lea(reason(var(c[0]))) == &c;
 }
 inline void Solver::newDecisionLevel()
 {
@@ -557,14 +800,48 @@ inline void Solver::clearInterrupt()
 {
     asynch_interrupt = false;
 }
+inline void Solver::requestStats()
+{
+    asynch_stats = true;
+}
+inline void Solver::setTickBudget(int64_t x)
+{
+    tick_budget = ticks + x;
+}
+inline void Solver::setTimeBudget(double secs)
+{
+    time_budget = realTime() + secs;
+    time_check = 0;
+    time_out = false;
+}
 inline void Solver::budgetOff()
 {
-    conflict_budget = propagation_budget = -1;
+    conflict_budget = propagation_budget = tick_budget = -1;
+    time_budget = 0;
+    time_out = false;
+}
+// NOTE: the clock is only read on every 256th call (see 'checkClock()').
+inline bool Solver::withinBudget()
+{
+    if ((time_budget > 0 || progress_fd >= 0) && --time_check <= 0)
+        checkClock();
+    return !asynch_interrupt && !mem_out && !time_out &&
+           (conflict_budget < 0 || conflicts < (uint64_t)conflict_budget) &&
+           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) &&
+           (tick_budget < 0 || ticks < (uint64_t)tick_budget);
 }
-inline bool Solver::withinBudget() const
+
+// Simplification, probing, vivification and local search call this in their loops, so that the
+// statistics and progress records due meanwhile are not held back until the next conflict. They
+// stop when it returns FALSE, on an interrupt or past the deadline; otherwise they end on their own
+// effort limits, not on the budget.
+inline bool Solver::poll()
 {
-    return !asynch_interrupt && (conflict_budget < 0 || conflicts < (uint64_t)conflict_budget) &&
-           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget);
+    if (asynch_stats)
+        report();
+    if ((time_budget > 0 || progress_fd >= 0) && --time_check <= 0)
+        checkClock();
+    return !asynch_interrupt && !time_out;
 }
 
 // FIXME: after the introduction of asynchronous interrruptions the solve-versions that return a
@@ -611,6 +888,11 @@ inline lbool Solver::solveLimited(const vec<Lit>& assumps)
     assumps.copyTo(assumptions);
     return solve_();
 }
+inline void Solver::startEnum(const vec<Var>& proj)
+{
+    vec<Lit> none;
+    startEnum(proj, none);
+}
 inline bool Solver::okay() const
 {
     return ok;
@@ -660,6 +942,35 @@ inline void Solver::toDimacs(const char* file, Lit p, Lit q, Lit r)
     toDimacs(file, as);
 }
 
+//=================================================================================================
+// Implementation of inline methods of 'Propagator':
+
+inline lbool Propagator::value(Var x) const
+{
+    return solver.value(x);
+}
+inline lbool Propagator::value(Lit p) const
+{
+    return solver.value(p);
+}
+inline int Propagator::level(Var x) const
+{
+    return solver.level(x);
+}
+inline int Propagator::decisionLevel() const
+{
+    return solver.decisionLevel();
+}
+inline const vec<Lit>& Propagator::trail() const
+{
+    return solver.trail;
+}
+inline void Propagator::enqueue(Lit p)
+{
+    solver.lazy_owner[var(p)] = id;
+    solver.uncheckedEnqueue(p, CRef_Lazy);
+}
+
 //=================================================================================================
 // Debug etc:
 
@@ -220,7 +220,8 @@ class Clause
         unsigned learnt : 1;
         unsigned has_extra : 1;
         unsigned reloced : 1;
-        unsigned size : 27;
+        unsigned flag : 1; // 'vivified()' for longer clauses, 'hbr()' for binaries
+        unsigned size : 26;
     } header;
     union {
         Lit lit;
@@ -238,6 +239,7 @@ class Clause
         header.learnt = learnt;
         header.has_extra = use_extra;
         header.reloced = 0;
+        header.flag = 0;
         header.size = ps.size();
 
         for (int i = 0; i < ps.size(); i++)
@@ -314,6 +316,26 @@ class Clause
         return data[header.size - 1].lit;
     }
 
+    // NOTE: binaries are never vivified, so they use the same header bit to mark hyper-binary
+    // resolvents (removable unlike other learnt binaries).
+    bool vivified() const
+    {
+        return header.size > 2 && header.flag;
+    }
+    void vivified(bool b)
+    {
+        header.flag = b;
+    }
+    bool hbr() const
+    {
+        return header.size == 2 && header.flag;
+    }
+    void hbr(bool b)
+    {
+        assert(header.size == 2);
+        header.flag = b;
+    }
+
     bool reloced() const
     {
         return header.reloced;
@@ -362,18 +384,19 @@ class Clause
 // ClauseAllocator -- a simple class for allocating memory for clauses:
 
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Lazy = CRef_Undef - 1; // Reason or conflict held by a propagator (see 'Propagator').
 class ClauseAllocator
 {
     RegionAllocator<uint32_t> ra;
 
+   public:
+    enum { Unit_Size = RegionAllocator<uint32_t>::Unit_Size };
+
     static uint32_t clauseWord32Size(int size, bool has_extra)
     {
         return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t);
     }
 
-   public:
-    enum { Unit_Size = RegionAllocator<uint32_t>::Unit_Size };
-
     bool extra_clause_field;
 
     ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false)
@@ -394,6 +417,8 @@ class ClauseAllocator
         assert(sizeof(Lit) == sizeof(uint32_t));
         assert(sizeof(float) == sizeof(uint32_t));
         bool use_extra = learnt | extra_clause_field;
+        if (ps.size() >= 1 << 26) // (the size field of the header has 26 bits)
+            throw OutOfMemoryException();
         CRef cid = ra.alloc(clauseWord32Size(ps.size(), use_extra));
         new (lea(cid)) Clause(ps, use_extra, learnt);
 
@@ -416,6 +441,10 @@ class ClauseAllocator
     {
         return ra.wasted();
     }
+    uint32_t capacity() const
+    {
+        return ra.capacity();
+    }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     Clause& operator[](CRef r)
@@ -547,6 +576,18 @@ class OccLists
     {
         return occs[idx];
     }
+    const Vec& operator[](const K& idx) const
+    {
+        return occs[idx];
+    }
+    uint64_t bytes() const // (the memory allocated by the lists, including their spare capacity)
+    {
+        uint64_t b = (uint64_t)occs.capacity() * sizeof(Vec) + (uint64_t)dirty.capacity() +
+                     (uint64_t)dirties.capacity() * sizeof(K);
+        for (const Vec* v = occs.begin(); v != occs.end(); v++)
+            b += (uint64_t)v->capacity() * sizeof((*v)[0]);
+        return b;
+    }
     Vec& lookup(const K& idx)
     {
         if (dirty[idx])
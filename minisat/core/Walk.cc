@@ -0,0 +1,175 @@
+/*****************************************************************************************[Walk.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+
+#include "minisat/core/Solver.h"
+#include "minisat/core/Walk.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor:
+
+// The probabilities follow '(eps + break)^-cb' with the ProbSAT parameters for 3-SAT.
+static const double walk_eps = 0.9;
+static const double walk_cb = 2.06;
+
+Walk::Walk(Solver& solver, int nvars)
+    : flips(0), solver(solver), nvars(nvars), seed(solver.random_seed)
+{
+    start.push(0);
+    for (int b = 0; b < 64; b++)
+        pbreak.push(pow(walk_eps + b, -walk_cb));
+}
+
+void Walk::addClause(const vec<Lit>& ps)
+{
+    for (int i = 0; i < ps.size(); i++) {
+        assert(var(ps[i]) < nvars);
+        lits.push(ps[i]);
+    }
+    start.push(lits.size());
+}
+
+//=================================================================================================
+// Search:
+
+int Walk::breakCount(Var v) const
+{
+    Lit t = mkLit(v, !value[v]);
+    int b = 0;
+    for (int i = occ_start[toInt(t)]; i < occ_start[toInt(t) + 1]; i++)
+        b += ntrue[occs[i]] == 1;
+    return b;
+}
+
+void Walk::flip(Var v)
+{
+    Lit t = mkLit(v, !value[v]);
+    value[v] ^= 1;
+    flips++;
+
+    for (int i = occ_start[toInt(t)]; i < occ_start[toInt(t) + 1]; i++) {
+        int c = occs[i];
+        if (--ntrue[c] == 0) {
+            where[c] = unsat.size();
+            unsat.push(c);
+        }
+    }
+    for (int i = occ_start[toInt(~t)]; i < occ_start[toInt(~t) + 1]; i++) {
+        int c = occs[i];
+        if (ntrue[c]++ == 0) {
+            int last = unsat.last();
+            unsat[where[c]] = last;
+            where[last] = where[c];
+            where[c] = -1;
+            unsat.pop();
+        }
+    }
+}
+
+void Walk::applyFlips(vec<char>& phase, int n)
+{
+    for (int i = 0; i < n; i++)
+        phase[flipped[i]] ^= 1;
+}
+
+// The best assignment is kept as 'phase' plus the first 'best_flips' flips of 'flipped': copying
+// the whole assignment on each new best would be quadratic, since early on almost every flip is
+// one. When the flips since the best outnumber the variables, they are dropped ('tracked' is
+// cleared) and the next best is copied from 'value' instead.
+bool Walk::run(vec<char>& phase, int64_t max_flips)
+{
+    int nclauses = start.size() - 1;
+
+    // Occurrence lists (by counting sort):
+    occ_start.clear();
+    occ_start.growTo(2 * nvars + 1, 0);
+    for (int i = 0; i < lits.size(); i++)
+        occ_start[toInt(lits[i]) + 1]++;
+    for (int i = 1; i < occ_start.size(); i++)
+        occ_start[i] += occ_start[i - 1];
+    vec<int> pos;
+    occ_start.copyTo(pos);
+    occs.growTo(lits.size());
+    for (int c = 0; c < nclauses; c++)
+        for (int i = start[c]; i < start[c + 1]; i++)
+            occs[pos[toInt(lits[i])]++] = c;
+
+    value.clear();
+    for (Var v = 0; v < nvars; v++)
+        value.push(!phase[v]);
+    ntrue.clear();
+    ntrue.growTo(nclauses, 0);
+    where.clear();
+    where.growTo(nclauses, -1);
+    unsat.clear();
+    for (int c = 0; c < nclauses; c++) {
+        for (int i = start[c]; i < start[c + 1]; i++)
+            ntrue[c] += isTrue(lits[i]);
+        if (ntrue[c] == 0) {
+            where[c] = unsat.size();
+            unsat.push(c);
+        }
+    }
+
+    int best = unsat.size(), best_flips = 0;
+    bool tracked = true;
+    flipped.clear();
+    for (int64_t f = 0; f < max_flips && unsat.size() > 0 && solver.poll(); f++) {
+        int c = unsat[Solver::irand(seed, unsat.size())];
+        double sum = 0;
+        probs.clear();
+        for (int i = start[c]; i < start[c + 1]; i++) {
+            int b = breakCount(var(lits[i]));
+            probs.push(pbreak[b < pbreak.size() ? b : pbreak.size() - 1]);
+            sum += probs.last();
+        }
+
+        double r = Solver::drand(seed) * sum;
+        int j = 0;
+        while (j < probs.size() - 1 && r >= probs[j])
+            r -= probs[j++];
+        Var v = var(lits[start[c] + j]);
+        flip(v);
+        if (tracked)
+            flipped.push(v);
+
+        if (unsat.size() < best) {
+            best = unsat.size();
+            if (tracked)
+                best_flips = flipped.size();
+            else {
+                for (Var x = 0; x < nvars; x++)
+                    phase[x] = !value[x];
+                tracked = true;
+            }
+        } else if (tracked && flipped.size() - best_flips > nvars) {
+            applyFlips(phase, best_flips);
+            flipped.clear();
+            best_flips = 0;
+            tracked = false;
+        }
+    }
+    if (tracked)
+        applyFlips(phase, best_flips);
+    return best == 0;
+}
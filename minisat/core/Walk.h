@@ -0,0 +1,91 @@
+/******************************************************************************************[Walk.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Walk_h
+#define Minisat_Walk_h
+
+#include "minisat/core/SolverTypes.h"
+#include "minisat/mtl/Vec.h"
+
+namespace Minisat {
+
+class Solver;
+
+//=================================================================================================
+// Walk -- stochastic local search (ProbSAT) over a fixed set of clauses:
+//
+// Each step picks a random falsified clause and flips one of its variables, chosen with a
+// probability that falls polynomially with its break count (the number of clauses it is the only
+// true literal of). Break counts are not cached: they are counted on the occurrences of the true
+// literal, using the number of true literals of each clause. The occurrence lists are stored in
+// one flat array, and the falsified clauses in a list with the position of each in it.
+
+class Walk
+{
+   public:
+    Walk(Solver& solver, int nvars); // Variables are '0 .. nvars-1'; the seed is the solver's.
+
+    void addClause(const vec<Lit>& ps); // Add a clause over distinct variables.
+
+    // Walk from the assignment 'phase' (the sign of the literal to decide per variable, as in
+    // 'Solver::polarity') for at most 'max_flips' flips (fewer if 'Solver::poll()' says to stop),
+    // and store the assignment with the fewest falsified clauses in 'phase'. Returns TRUE if it
+    // satisfies every clause.
+    bool run(vec<char>& phase, int64_t max_flips);
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t flips;
+
+   protected:
+    Solver& solver; // (polled while walking, see 'Solver::poll()')
+    int nvars;
+    double& seed;
+
+    vec<Lit> lits;      // The literals of all clauses, ...
+    vec<int> start;     // ... the start of each clause in 'lits' (and the end of the last), ...
+    vec<int> ntrue;     // ... and the number of its literals true in 'value'.
+    vec<int> occ_start; // The start of the clauses of each literal in 'occs' (by 'toInt()').
+    vec<int> occs;
+    vec<int> unsat;     // The falsified clauses, ...
+    vec<int> where;     // ... and the position of each clause in 'unsat' (or -1).
+    vec<char> value;    // The current assignment (TRUE means the variable is true).
+    vec<double> pbreak; // The (unnormalized) probability of picking a variable by break count.
+    vec<double> probs;
+    vec<Var> flipped;   // The flips made since 'phase' was last brought up to date in 'run()'.
+
+    bool isTrue(Lit p) const;
+    int breakCount(Var v) const;
+    void flip(Var v);
+    void applyFlips(vec<char>& phase, int n); // Apply the first 'n' flips of 'flipped' to 'phase'.
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline bool Walk::isTrue(Lit p) const
+{
+    return value[var(p)] ^ sign(p);
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
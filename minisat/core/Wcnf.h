@@ -0,0 +1,91 @@
+/******************************************************************************************[Wcnf.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#ifndef Minisat_Wcnf_h
+#define Minisat_Wcnf_h
+
+#include <stdio.h>
+
+#include "minisat/core/Dimacs.h"
+#include "minisat/core/SolverTypes.h"
+#include "minisat/utils/ParseUtils.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// WCNF Parser:
+//
+// Weighted partial MaxSAT problems, in either format of the MaxSAT evaluations: a clause is
+// preceded by its weight, and it is hard if its weight is at least the 'top' weight of the header
+// 'p wcnf <vars> <clauses> <top>' or if it is preceded by 'h' instead (in which case there is no
+// header).
+
+template <class B, class Solver>
+static void parse_WCNF_main(B& in, Solver& S)
+{
+    vec<Lit> lits;
+    int64_t top = -1;
+    for (;;) {
+        skipWhitespace(in);
+        if (*in == EOF)
+            break;
+        else if (*in == 'p') {
+            if (eagerMatch(in, "p wcnf")) {
+                parseInt(in);
+                parseInt(in);
+                while (*in == ' ' || *in == '\t')
+                    ++in;
+                if (*in >= '0' && *in <= '9')
+                    top = parseInt64(in);
+            } else
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+        } else if (*in == 'c')
+            skipLine(in);
+        else if (*in == 'h') {
+            ++in;
+            readClause(in, S, lits);
+            S.addClause_(lits);
+        } else {
+            int64_t w = parseInt64(in);
+            if (w < 0)
+                printf("PARSE ERROR! Negative weight: %" PRId64 "\n", w), exit(3);
+            readClause(in, S, lits);
+            if (top != -1 && w >= top)
+                S.addClause_(lits);
+            else
+                S.addSoft(lits, w);
+        }
+    }
+}
+
+// Inserts problem into solver.
+//
+template <class Solver>
+static void parse_WCNF(gzFile input_stream, Solver& S)
+{
+    StreamBuffer in(input_stream);
+    parse_WCNF_main(in, S);
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
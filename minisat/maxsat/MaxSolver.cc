@@ -0,0 +1,313 @@
+/************************************************************************************[MaxSolver.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#include "minisat/maxsat/MaxSolver.h"
+#include "minisat/utils/Options.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Options:
+
+static const char* _cat = "MAXSAT";
+
+static BoolOption opt_stratify(_cat, "strat", "Introduce soft clauses by decreasing weight.", true);
+static BoolOption opt_exhaust(_cat, "exhaust",
+                              "Raise the bound of new totalizers while the hard clauses imply it.",
+                              true);
+static IntOption opt_exhaust_confl(_cat, "exhaust-confl",
+                                   "Conflict budget of each core exhaustion step.", 1000,
+                                   IntRange(0, INT32_MAX));
+
+//=================================================================================================
+// Constructor/Destructor:
+
+MaxSolver::MaxSolver()
+    : cost(UINT64_MAX),
+      lower_bound(0),
+      verbosity(0),
+      stratify(opt_stratify),
+      exhaust(opt_exhaust),
+      exhaust_confl(opt_exhaust_confl),
+      sat_calls(0),
+      cores(0),
+      exhausted(0),
+      soft_relaxed(0)
+{
+    soft_start.push(0);
+}
+
+MaxSolver::~MaxSolver()
+{
+}
+
+//=================================================================================================
+// Problem specification:
+
+// The clause is turned into an assumption at the next call to 'solve()' (so that the variables of
+// the problem are not interleaved with relaxation variables while it is read).
+void MaxSolver::addSoft(const vec<Lit>& ps, uint64_t w)
+{
+    if (w == 0)
+        return;
+    for (int i = 0; i < ps.size(); i++)
+        soft_lits.push(ps[i]);
+    soft_start.push(soft_lits.size());
+    soft_w.push(w);
+}
+
+// Soft clauses of more than one literal are relaxed by a fresh variable; assuming it false enforces
+// the clause.
+void MaxSolver::relaxSoft(int i)
+{
+    int size = soft_start[i + 1] - soft_start[i];
+    if (size == 0)
+        lower_bound += soft_w[i];
+    else if (size == 1)
+        addAssumption(soft_lits[soft_start[i]], soft_w[i], -1, 0);
+    else {
+        Lit b = mkLit(solver.newVar());
+        vec<Lit> relaxed;
+        for (int j = soft_start[i]; j < soft_start[i + 1]; j++)
+            relaxed.push(soft_lits[j]);
+        relaxed.push(b);
+        solver.addClause_(relaxed);
+        addAssumption(~b, soft_w[i], -1, 0);
+    }
+}
+
+int MaxSolver::addAssumption(Lit p, uint64_t w, int tot, int bound)
+{
+    assump_of.growTo(toInt(p) + 1, -1);
+    int a = assump_of[toInt(p)];
+    if (a != -1) {
+        weights[a] += w;
+        return a;
+    }
+    a = assumps.size();
+    assump_of[toInt(p)] = a;
+    assumps.push(p);
+    weights.push(w);
+    assump_tot.push(tot);
+    assump_bound.push(bound);
+    return a;
+}
+
+//=================================================================================================
+// Totalizers:
+
+int MaxSolver::buildNode(const vec<Lit>& ins, int lo, int hi)
+{
+    int left = -1, right = -1;
+    if (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        left = buildNode(ins, lo, mid);
+        right = buildNode(ins, mid, hi);
+    }
+    int n = node_size.size();
+    node_left.push(left);
+    node_right.push(right);
+    node_size.push(hi - lo);
+    node_outs.push();
+    if (left == -1)
+        node_outs[n].push(ins[lo]);
+    return n;
+}
+
+// Encode the outputs of node 'n' up to 'at least k true' (only the direction needed to make them
+// true, since they are only ever assumed false).
+void MaxSolver::extendNode(int n, int k)
+{
+    int want = k < node_size[n] ? k : node_size[n];
+    int old = node_outs[n].size();
+    if (node_left[n] == -1 || want <= old)
+        return;
+
+    int l = node_left[n], r = node_right[n];
+    extendNode(l, k);
+    extendNode(r, k);
+    for (int i = old; i < want; i++)
+        node_outs[n].push(mkLit(solver.newVar()));
+
+    const vec<Lit>& ls = node_outs[l];
+    const vec<Lit>& rs = node_outs[r];
+    const vec<Lit>& os = node_outs[n];
+    vec<Lit> c;
+    for (int i = 0; i <= ls.size(); i++)
+        for (int j = 0; j <= rs.size(); j++) {
+            if (i + j <= old || i + j > want)
+                continue;
+            c.clear();
+            if (i > 0)
+                c.push(~ls[i - 1]);
+            if (j > 0)
+                c.push(~rs[j - 1]);
+            c.push(os[i + j - 1]);
+            solver.addClause_(c);
+        }
+}
+
+Lit MaxSolver::totOutput(int t, int k)
+{
+    int root = tot_root[t];
+    if (k > node_size[root])
+        return lit_Undef;
+    extendNode(root, k);
+    return node_outs[root][k - 1];
+}
+
+//=================================================================================================
+// Solving:
+
+void MaxSolver::checkModel()
+{
+    uint64_t c = 0;
+    for (int i = 0; i < soft_w.size(); i++) {
+        bool sat = false;
+        for (int j = soft_start[i]; j < soft_start[i + 1] && !sat; j++)
+            sat = solver.modelValue(soft_lits[j]) == l_True;
+        if (!sat)
+            c += soft_w[i];
+    }
+    if (c < cost) {
+        cost = c;
+        solver.model.copyTo(model);
+        if (verbosity >= 1)
+            printf("o %" PRIu64 "\n", cost);
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  relaxCore : ()  ->  [void]
+|
+|  Description:
+|    Process the core in the final conflict of the solver: its minimum weight goes to the lower
+|    bound, assumed totalizer outputs in it get a successor allowing one more violation, and its
+|    violated assumptions are counted by a new totalizer (with the bound exhausted if enabled).
+|________________________________________________________________________________________________@*/
+void MaxSolver::relaxCore()
+{
+    cores++;
+    core.clear();
+    uint64_t minw = UINT64_MAX;
+    for (int i = 0; i < solver.conflict.size(); i++) {
+        Lit p = ~solver.conflict[i];
+        core.push(p);
+        if (weights[assump_of[toInt(p)]] < minw)
+            minw = weights[assump_of[toInt(p)]];
+    }
+    lower_bound += minw;
+
+    for (int i = 0; i < core.size(); i++) {
+        int a = assump_of[toInt(core[i])];
+        weights[a] -= minw;
+        if (assump_tot[a] != -1) {
+            int t = assump_tot[a], k = assump_bound[a] + 1;
+            Lit o = totOutput(t, k);
+            if (o != lit_Undef)
+                addAssumption(~o, minw, t, k);
+        }
+    }
+
+    if (core.size() == 1) {
+        solver.addClause(~core[0]);
+        return;
+    }
+
+    // Count the violated assumptions of the core:
+    vec<Lit> ins;
+    for (int i = 0; i < core.size(); i++)
+        ins.push(~core[i]);
+    int t = tot_root.size();
+    tot_root.push(buildNode(ins, 0, ins.size()));
+
+    int k = 2;
+    for (; exhaust && k <= ins.size(); k++) {
+        vec<Lit> as;
+        as.push(~totOutput(t, k));
+        solver.setConfBudget(exhaust_confl);
+        lbool ret = solver.solveLimited(as);
+        solver.budgetOff();
+        if (ret == l_True)
+            checkModel();
+        if (ret != l_False || solver.conflict.size() == 0)
+            break;
+        exhausted++;
+        lower_bound += minw;
+        solver.addClause(~as[0]);
+    }
+    if (k <= ins.size())
+        addAssumption(~totOutput(t, k), minw, t, k);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  solve : ()  ->  [lbool]
+|
+|  Description:
+|    Alternate between solving under the assumptions with enough weight (all of them without
+|    stratification) and relaxing the cores found. A model found with all assumptions of positive
+|    weight is optimal; otherwise the weight limit is lowered to the next weight.
+|________________________________________________________________________________________________@*/
+lbool MaxSolver::solve()
+{
+    for (; soft_relaxed < soft_w.size(); soft_relaxed++)
+        relaxSoft(soft_relaxed);
+    if (!solver.okay())
+        return l_False;
+
+    uint64_t limit = 1;
+    if (stratify)
+        for (int i = 0; i < weights.size(); i++)
+            if (weights[i] > limit)
+                limit = weights[i];
+
+    vec<Lit> as;
+    for (;;) {
+        as.clear();
+        for (int i = 0; i < assumps.size(); i++)
+            if (weights[i] > 0 && weights[i] >= limit)
+                as.push(assumps[i]);
+
+        sat_calls++;
+        lbool ret = solver.solveLimited(as);
+        if (ret == l_Undef)
+            return l_Undef;
+        else if (ret == l_False) {
+            if (solver.conflict.size() == 0)
+                return l_False;
+            relaxCore();
+            continue;
+        }
+
+        checkModel();
+        uint64_t next = 0;
+        for (int i = 0; i < weights.size(); i++)
+            if (weights[i] > next && weights[i] < limit)
+                next = weights[i];
+        if (next == 0 || cost == lower_bound) {
+            assert(cost == lower_bound);
+            return l_True;
+        }
+        limit = next;
+    }
+}
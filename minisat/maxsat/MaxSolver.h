@@ -0,0 +1,140 @@
+/*************************************************************************************[MaxSolver.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+
+#ifndef Minisat_MaxSolver_h
+#define Minisat_MaxSolver_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// MaxSolver -- core-guided weighted partial MaxSAT (OLL):
+//
+// Every soft clause is turned into an assumption (a unit soft clause is its own literal, others get
+// a relaxation variable). Solving under the assumptions either gives a model or a core, whose
+// minimum weight is added to the lower bound and subtracted from all its assumptions. The core is
+// then relaxed by a totalizer over its violated assumptions, whose output 'at least 2 violated' is
+// assumed false with the weight of the core; assumed totalizer outputs that show up in later cores
+// allow one more violation. Totalizers only encode the outputs needed so far and are extended on
+// demand. Everything happens in one incremental solver, so learnt clauses are kept throughout.
+//
+// Assumptions are introduced by decreasing weight (stratification), and the bound of a new
+// totalizer is raised while the hard clauses alone imply it (core exhaustion).
+
+class MaxSolver
+{
+   public:
+    // Constructor/Destructor:
+    //
+    MaxSolver();
+    ~MaxSolver();
+
+    // Problem specification:
+    //
+    Var newVar();                                 // Add a new variable.
+    int nVars() const;                            // The current number of variables.
+    bool addClause_(vec<Lit>& ps);                // Add a hard clause (may change 'ps').
+    void addSoft(const vec<Lit>& ps, uint64_t w); // Add a soft clause of weight 'w'.
+    int nSoft() const;                            // The number of soft clauses.
+
+    // Solving:
+    //
+    lbool solve(); // Find an optimal model. Returns l_False if the hard clauses are unsatisfiable,
+                   // and l_Undef if interrupted (the best model found is then in 'model').
+    void interrupt(); // Trigger a (potentially asynchronous) interruption of the solver.
+
+    // Extra results: (read-only member variable)
+    //
+    vec<lbool> model;     // The best model found (if any).
+    uint64_t cost;        // The weight of the soft clauses falsified by 'model'.
+    uint64_t lower_bound; // No model falsifies soft clauses of less weight.
+
+    // Mode of operation:
+    //
+    int verbosity;
+    bool stratify;     // Introduce assumptions by decreasing weight.
+    bool exhaust;      // Raise the bound of new totalizers while the hard clauses imply it.
+    int exhaust_confl; // Conflict budget of each exhaustion step.
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t sat_calls, cores, exhausted;
+
+    Solver solver; // The underlying incremental solver.
+
+   protected:
+    vec<Lit> soft_lits;      // The literals of all soft clauses, ...
+    vec<int> soft_start;     // ... the start of each clause in 'soft_lits' (and the end of the last), ...
+    vec<uint64_t> soft_w;    // ... and its weight.
+    int soft_relaxed;        // The number of soft clauses turned into assumptions.
+
+    vec<Lit> assumps;        // Literals assumed true, ...
+    vec<uint64_t> weights;   // ... the remaining weight of each, ...
+    vec<int> assump_tot;     // ... the totalizer it is an output of (or -1), ...
+    vec<int> assump_bound;   // ... and its bound then ('assumps[i]' is 'at most bound violated').
+    vec<int> assump_of;      // The index of each literal in 'assumps' (indexed by 'toInt()').
+
+    // Totalizer nodes: each counts the true literals below it in unary ('outs[i]' is implied by
+    // 'at least i+1 true').
+    vec<int> node_left, node_right, node_size;
+    vec<vec<Lit> > node_outs;
+    vec<int> tot_root;       // The root node of each totalizer.
+
+    vec<Lit> core;
+
+    void relaxSoft(int i);
+    int addAssumption(Lit p, uint64_t w, int tot, int bound);
+    int buildNode(const vec<Lit>& ins, int lo, int hi);
+    void extendNode(int n, int k);
+    Lit totOutput(int t, int k); // The output 'at least k true' of totalizer 't' (k > 0).
+    void relaxCore();
+    void checkModel();
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline Var MaxSolver::newVar()
+{
+    return solver.newVar();
+}
+inline int MaxSolver::nVars() const
+{
+    return solver.nVars();
+}
+inline bool MaxSolver::addClause_(vec<Lit>& ps)
+{
+    return solver.addClause_(ps);
+}
+inline int MaxSolver::nSoft() const
+{
+    return soft_w.size();
+}
+inline void MaxSolver::interrupt()
+{
+    solver.interrupt();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
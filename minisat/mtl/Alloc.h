@@ -63,6 +63,10 @@ class RegionAllocator
     {
         return wasted_;
     }
+    uint32_t capacity() const
+    {
+        return cap;
+    }
 
     Ref alloc(int size);
     void free(int size)
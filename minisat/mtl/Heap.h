@@ -94,6 +94,10 @@ class Heap
     {
         return heap.size() == 0;
     }
+    uint64_t bytes() const // (the memory allocated by the heap)
+    {
+        return (uint64_t)heap.capacity() * sizeof(K) + (uint64_t)indices.capacity() * sizeof(int);
+    }
     bool inHeap(K k) const
     {
         return indices.has(k) && indices[k] >= 0;
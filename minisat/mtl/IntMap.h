@@ -46,6 +46,10 @@ class IntMap
     {
         return index(k) < map.size();
     }
+    int capacity() const
+    {
+        return map.capacity();
+    }
 
     const V& operator[](K k) const
     {
@@ -51,6 +51,10 @@ class Queue
     {
         return (end >= first) ? end - first : end - first + buf.size();
     }
+    uint64_t bytes() const // (the memory allocated by the queue)
+    {
+        return (uint64_t)buf.capacity() * sizeof(T);
+    }
 
     const T& operator[](int index) const
     {
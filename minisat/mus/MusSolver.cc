@@ -0,0 +1,301 @@
+/************************************************************************************[MusSolver.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/mus/MusSolver.h"
+#include "minisat/utils/Options.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Options:
+
+static const char* _cat = "MUS";
+
+static BoolOption opt_refine(_cat, "refine",
+                             "Drop the clauses outside the core of each unsatisfiable check.",
+                             true);
+static BoolOption opt_rotate(_cat, "rotate", "Use model rotation on satisfiable checks.", true);
+static IntOption opt_check_confl(_cat, "check-confl",
+                                 "Conflict budget of each check (-1 means none).", -1,
+                                 IntRange(-1, INT32_MAX));
+
+//=================================================================================================
+// Constructor/Destructor:
+
+MusSolver::MusSolver()
+    : minimal(true),
+      verbosity(0),
+      refine(opt_refine),
+      rotate(opt_rotate),
+      check_confl(opt_check_confl),
+      checks(0),
+      refined(0),
+      rotated(0),
+      undecided(0),
+      interrupted(false)
+{
+    cand_start.push(0);
+    hard_start.push(0);
+}
+
+MusSolver::~MusSolver()
+{
+}
+
+//=================================================================================================
+// Problem specification:
+
+void MusSolver::addOccs(const vec<Lit>& ps, int cl)
+{
+    for (int i = 0; i < ps.size(); i++) {
+        occs.growTo(toInt(ps[i]) + 1);
+        vec<int>& os = occs[toInt(ps[i])];
+        if (os.size() == 0 || os.last() != cl)
+            os.push(cl);
+    }
+}
+
+// The selector is only added by 'extract()' (so that the variables of the problem are not
+// interleaved with selector variables while it is read).
+bool MusSolver::addClause_(vec<Lit>& ps)
+{
+    addOccs(ps, 2 * status.size());
+    for (int i = 0; i < ps.size(); i++)
+        cand_lits.push(ps[i]);
+    cand_start.push(cand_lits.size());
+    status.push(unknown);
+    return true;
+}
+
+bool MusSolver::addHard(vec<Lit>& ps)
+{
+    addOccs(ps, 2 * (hard_start.size() - 1) + 1);
+    for (int i = 0; i < ps.size(); i++)
+        hard_lits.push(ps[i]);
+    hard_start.push(hard_lits.size());
+    return solver.addClause_(ps);
+}
+
+//=================================================================================================
+// Extraction:
+
+// Decided candidates are fixed for good: the clauses of the MUS are added, the others removed.
+void MusSolver::setStatus(int c, char st)
+{
+    assert(status[c] == unknown);
+    status[c] = st;
+    solver.addClause(st == necessary ? selectors[c] : ~selectors[c]);
+}
+
+// Remove the undecided candidates whose selectors are not in the final conflict.
+void MusSolver::refineCore()
+{
+    vec<char> in_core(status.size(), 0);
+    for (int i = 0; i < solver.conflict.size(); i++) {
+        Var v = var(solver.conflict[i]);
+        if (v < cand_of.size() && cand_of[v] != -1)
+            in_core[cand_of[v]] = 1;
+    }
+    for (int c = 0; c < status.size(); c++)
+        if (status[c] == unknown && !in_core[c]) {
+            setStatus(c, removed);
+            refined++;
+        }
+}
+
+int MusSolver::onlyFalsified(Lit p)
+{
+    if (toInt(p) >= occs.size())
+        return -1;
+    const vec<int>& os = occs[toInt(p)];
+    int found = -1;
+    for (int i = 0; i < os.size(); i++) {
+        int cl = os[i] >> 1;
+        bool hard = os[i] & 1;
+        if (!hard && status[cl] == removed)
+            continue;
+
+        const Lit* begin = hard ? &hard_lits[0] + hard_start[cl] : &cand_lits[0] + cand_start[cl];
+        const Lit* end = hard ? &hard_lits[0] + hard_start[cl + 1]
+                              : &cand_lits[0] + cand_start[cl + 1];
+        bool falsified = true;
+        for (const Lit* q = begin; q != end && falsified; q++)
+            falsified = (rot_model[var(*q)] ^ sign(*q)) == l_False;
+        if (!falsified)
+            continue;
+        if (hard || found != -1)
+            return -2;
+        found = cl;
+    }
+    return found;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  rotateModel : (c : int)  ->  [void]
+|
+|  Description:
+|    The solver's model falsifies candidate 'c' and satisfies every other clause left, so 'c' is
+|    in the MUS. Flipping one of its literals satisfies it; if that falsifies exactly one other
+|    candidate (and no hard clause), the flipped model is a witness for that candidate in turn.
+|    The recursion is done with an explicit stack, undoing each flip when its candidate is done.
+|________________________________________________________________________________________________@*/
+void MusSolver::rotateModel(int c)
+{
+    solver.model.copyTo(rot_model);
+    vec<int> stack_cand, stack_pos;
+    vec<Var> stack_flip;
+    stack_cand.push(c);
+    stack_pos.push(cand_start[c]);
+    stack_flip.push(var_Undef);
+
+    while (stack_cand.size() > 0) {
+        int top = stack_cand.size() - 1;
+        int pos = stack_pos[top];
+        if (pos == cand_start[stack_cand[top] + 1]) {
+            if (stack_flip[top] != var_Undef)
+                rot_model[stack_flip[top]] = rot_model[stack_flip[top]] ^ true;
+            stack_cand.pop();
+            stack_pos.pop();
+            stack_flip.pop();
+            continue;
+        }
+        stack_pos[top]++;
+
+        Lit p = cand_lits[pos];
+        assert((rot_model[var(p)] ^ sign(p)) == l_False);
+        rot_model[var(p)] = rot_model[var(p)] ^ true;
+        int d = onlyFalsified(~p);
+        if (d >= 0 && status[d] == unknown) {
+            setStatus(d, necessary);
+            rotated++;
+            stack_cand.push(d);
+            stack_pos.push(cand_start[d]);
+            stack_flip.push(var(p));
+        } else
+            rot_model[var(p)] = rot_model[var(p)] ^ true;
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  extract : ()  ->  [lbool]
+|
+|  Description:
+|    Deletion-based MUS extraction. The undecided candidates are assumed active and the set is
+|    kept unsatisfiable throughout; each check deactivates one candidate. The result is in 'mus'.
+|________________________________________________________________________________________________@*/
+lbool MusSolver::extract()
+{
+    for (int c = selectors.size(); c < status.size(); c++) {
+        Lit s = mkLit(solver.newVar());
+        selectors.push(s);
+        cand_of.growTo(var(s) + 1, -1);
+        cand_of[var(s)] = c;
+
+        vec<Lit> ps;
+        for (int i = cand_start[c]; i < cand_start[c + 1]; i++)
+            ps.push(cand_lits[i]);
+        ps.push(~s);
+        solver.addClause_(ps);
+    }
+    mus.clear();
+    minimal = true;
+
+    vec<Lit> as;
+    for (int c = 0; c < status.size(); c++)
+        if (status[c] == unknown)
+            as.push(selectors[c]);
+    checks++;
+    lbool ret = solver.solveLimited(as);
+    if (ret != l_False)
+        return ret;
+    refineCore();
+
+    for (int c = 0; c < status.size(); c++) {
+        if (status[c] != unknown)
+            continue;
+        if (interrupted)
+            return l_Undef;
+
+        as.clear();
+        as.push(~selectors[c]);
+        for (int d = 0; d < status.size(); d++)
+            if (d != c && status[d] == unknown)
+                as.push(selectors[d]);
+
+        checks++;
+        if (check_confl >= 0)
+            solver.setConfBudget(check_confl);
+        ret = solver.solveLimited(as);
+        solver.budgetOff();
+
+        if (ret == l_False) {
+            setStatus(c, removed);
+            if (refine)
+                refineCore();
+        } else if (ret == l_True) {
+            setStatus(c, necessary);
+            if (rotate)
+                rotateModel(c);
+        } else if (interrupted)
+            return l_Undef;
+        else {
+            setStatus(c, necessary);
+            undecided++;
+            minimal = false;
+        }
+
+        if (verbosity >= 1 && checks % 100 == 0)
+            printf("c %" PRIu64 " checks, %d candidates decided\n", checks, c + 1);
+    }
+
+    for (int c = 0; c < status.size(); c++)
+        if (status[c] == necessary)
+            mus.push(c);
+    return l_False;
+}
+
+//=================================================================================================
+// Writing the MUS:
+
+void MusSolver::toDimacs(FILE* f)
+{
+    int max_var = 0, nclauses = mus.size() + hard_start.size() - 1;
+    for (int i = 0; i < hard_lits.size(); i++)
+        if (var(hard_lits[i]) + 1 > max_var)
+            max_var = var(hard_lits[i]) + 1;
+    for (int i = 0; i < mus.size(); i++)
+        for (int j = cand_start[mus[i]]; j < cand_start[mus[i] + 1]; j++)
+            if (var(cand_lits[j]) + 1 > max_var)
+                max_var = var(cand_lits[j]) + 1;
+
+    fprintf(f, "p cnf %d %d\n", max_var, nclauses);
+    for (int i = 0; i + 1 < hard_start.size(); i++) {
+        for (int j = hard_start[i]; j < hard_start[i + 1]; j++)
+            fprintf(f, "%s%d ", sign(hard_lits[j]) ? "-" : "", var(hard_lits[j]) + 1);
+        fprintf(f, "0\n");
+    }
+    for (int i = 0; i < mus.size(); i++) {
+        for (int j = cand_start[mus[i]]; j < cand_start[mus[i] + 1]; j++)
+            fprintf(f, "%s%d ", sign(cand_lits[j]) ? "-" : "", var(cand_lits[j]) + 1);
+        fprintf(f, "0\n");
+    }
+}
@@ -0,0 +1,132 @@
+/*************************************************************************************[MusSolver.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_MusSolver_h
+#define Minisat_MusSolver_h
+
+#include "minisat/core/Solver.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// MusSolver -- minimal unsatisfiable subsets by deletion:
+//
+// Every candidate clause gets a selector literal that activates it when assumed true. Candidates
+// are tested one at a time by solving without them: if the rest is still unsatisfiable the clause
+// is dropped, together with all candidates outside the final conflict of that call (clause-set
+// refinement); otherwise it belongs to the MUS, and the model is rotated: flipping each literal of
+// the clause may give a model falsifying exactly one other candidate, which then belongs to the
+// MUS as well, and so on recursively. Decided candidates become units, so one incremental solver
+// does all the checks.
+
+class MusSolver
+{
+   public:
+    // Constructor/Destructor:
+    //
+    MusSolver();
+    ~MusSolver();
+
+    // Problem specification:
+    //
+    Var newVar();                  // Add a new variable.
+    int nVars() const;             // The current number of variables.
+    bool addClause_(vec<Lit>& ps); // Add a candidate clause.
+    bool addHard(vec<Lit>& ps);    // Add a clause that is part of every subset (may change 'ps').
+    int nCandidates() const;       // The number of candidate clauses.
+
+    // Solving:
+    //
+    lbool extract(); // Find an MUS among the candidates. Returns l_True if all clauses together are
+                     // satisfiable, and l_Undef if interrupted.
+    void interrupt(); // Trigger a (potentially asynchronous) interruption of the solver.
+
+    void toDimacs(FILE* f); // Write the hard clauses and the MUS to a file in DIMACS-format.
+
+    // Extra results: (read-only member variable)
+    //
+    vec<int> mus; // The indices of the candidates in the MUS (in the order they were added).
+    bool minimal; // FALSE if some checks ran out of budget (their candidates were kept).
+
+    // Mode of operation:
+    //
+    int verbosity;
+    bool refine;     // Drop the candidates outside of the final conflict of unsatisfiable checks.
+    bool rotate;     // Use model rotation on satisfiable checks.
+    int check_confl; // Conflict budget of each check (-1 means none).
+
+    // Statistics: (read-only member variable)
+    //
+    uint64_t checks, refined, rotated, undecided;
+
+    Solver solver; // The underlying incremental solver.
+
+   protected:
+    enum { unknown = 0, necessary = 1, removed = 2 };
+
+    vec<Lit> cand_lits;  // The literals of all candidates, ...
+    vec<int> cand_start; // ... the start of each in 'cand_lits' (and the end of the last), ...
+    vec<char> status;    // ... and whether it is known to be in the MUS or not.
+    vec<Lit> selectors;  // The selector of each candidate (created by 'extract()').
+    vec<int> cand_of;    // The candidate of each selector variable (or -1).
+
+    vec<Lit> hard_lits;  // The literals of all hard clauses, ...
+    vec<int> hard_start; // ... and the start of each in 'hard_lits' (and the end of the last).
+
+    // The clauses containing each literal (indexed by 'toInt()'): candidates 'c' are stored as
+    // '2c', hard clauses 'h' as '2h+1'.
+    vec<vec<int> > occs;
+
+    vec<lbool> rot_model; // The model being rotated.
+    bool interrupted;
+
+    void addOccs(const vec<Lit>& ps, int cl);
+    void setStatus(int c, char st);
+    void refineCore();
+    int onlyFalsified(Lit p); // The only candidate falsified by 'rot_model' among the clauses
+                              // containing 'p', -1 if none, -2 if more or if a hard one is.
+    void rotateModel(int c);
+};
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline Var MusSolver::newVar()
+{
+    return solver.newVar();
+}
+inline int MusSolver::nVars() const
+{
+    return solver.nVars();
+}
+inline int MusSolver::nCandidates() const
+{
+    return status.size();
+}
+inline void MusSolver::interrupt()
+{
+    interrupted = true;
+    solver.interrupt();
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <zlib.h>
 
 #include "minisat/core/Dimacs.h"
+#include "minisat/core/Opb.h"
 #include "minisat/simp/SimpSolver.h"
 #include "minisat/utils/Options.h"
 #include "minisat/utils/ParseUtils.h"
@@ -39,6 +40,12 @@ static void SIGINT_interrupt(int)
     solver->interrupt();
 }
 
+// Print the statistics at the next conflict, without stopping:
+static void SIGUSR1_stats(int)
+{
+    solver->requestStats();
+}
+
 // Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
 // destructors and may cause deadlocks if a malloc/free function happens to be running (these
 // functions are guarded by locks for multithreaded use).
@@ -54,6 +61,18 @@ static void SIGINT_exit(int)
     _exit(1);
 }
 
+// Write the statistics of 'S' to 'file' (if given) as one JSON object:
+static void writeStatsJson(const Solver& S, const char* file)
+{
+    if (file == NULL)
+        return;
+    FILE* f = fopen(file, "wb");
+    if (f == NULL)
+        printf("ERROR! Could not open file: %s\n", file);
+    else
+        S.printStatsJson(f), fclose(f);
+}
+
 //=================================================================================================
 // Main:
 
@@ -62,7 +81,7 @@ int main(int argc, char** argv)
     try {
         setUsageHelp(
             "USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either "
-            "in plain or gzipped DIMACS.\n");
+            "in plain or gzipped DIMACS (or OPB, see '-opb').\n");
         setX86FPUPrecision();
 
         // Extra options:
@@ -79,7 +98,29 @@ int main(int argc, char** argv)
                           IntRange(0, INT32_MAX));
         IntOption mem_lim("MAIN", "mem-lim", "Limit on memory usage in megabytes.\n", 0,
                           IntRange(0, INT32_MAX));
+        IntOption wall_lim("MAIN", "wall-lim",
+                           "Limit on wall-clock time allowed in seconds (checked by the solver).\n",
+                           0, IntRange(0, INT32_MAX));
+        IntOption tick_lim("MAIN", "tick-lim",
+                           "Limit on the ticks of search (watcher visits and clause literal "
+                           "accesses) in millions, for machine independent timeouts.\n",
+                           0, IntRange(0, INT32_MAX));
         BoolOption strictp("MAIN", "strict", "Validate DIMACS header during parsing.", false);
+        BoolOption opb("MAIN", "opb", "Read the input in OPB (pseudo-Boolean) format.", false);
+        StringOption stats_json("MAIN", "stats-json",
+                                "If given, write the statistics and phase times as JSON to this "
+                                "file.");
+        BoolOption hw_counters("MAIN", "hw-counters",
+                               "Count hardware events (cycles, instructions, cache and branch "
+                               "misses) in each phase (Linux only, slows the solver down).",
+                               false);
+        IntOption progress_fd("MAIN", "progress-fd",
+                              "Write JSON progress records to this file descriptor (-1 means "
+                              "none).",
+                              -1, IntRange(-1, INT32_MAX));
+        DoubleOption progress_int("MAIN", "progress-int",
+                                  "Wall-clock seconds between progress records.", 1.0,
+                                  DoubleRange(0, true, HUGE_VAL, false));
 
         parseOptions(argc, argv, true);
 
@@ -90,17 +131,26 @@ int main(int argc, char** argv)
             S.eliminate(true);
 
         S.verbosity = verb;
+        if (hw_counters && !S.prof.openHw())
+            printf("WARNING: hardware counters are not available ('perf_event_open()' failed)\n");
+        S.progress_fd = progress_fd;
+        S.progress_int = progress_int;
 
         solver = &S;
         // Use signal handlers that forcibly quit until the solver will be able to respond to
         // interrupts:
         sigTerm(SIGINT_exit);
+        sigStats(SIGUSR1_stats);
 
         // Try to set resource limits:
         if (cpu_lim != 0)
             limitTime(cpu_lim);
         if (mem_lim != 0)
             limitMemory(mem_lim);
+        if (wall_lim != 0)
+            S.setTimeBudget(wall_lim);
+        if (tick_lim != 0)
+            S.setTickBudget((int64_t)tick_lim * 1000000);
 
         if (argc == 1)
             printf("Reading from standard input... Use '--help' for help.\n");
@@ -118,8 +168,12 @@ int main(int argc, char** argv)
                 "|\n");
         }
 
-        parse_DIMACS(in, S, (bool)strictp);
+        if (opb)
+            parse_OPB(in, S);
+        else
+            parse_DIMACS(in, S, (bool)strictp);
         gzclose(in);
+        int input_vars = S.nVars(); // (preprocessing may introduce auxiliary variables)
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
 
         if (S.verbosity > 0) {
@@ -160,6 +214,7 @@ int main(int argc, char** argv)
                 printf("\n");
             }
             printf("UNSATISFIABLE\n");
+            writeStatsJson(S, stats_json);
             exit(20);
         }
 
@@ -182,10 +237,11 @@ int main(int argc, char** argv)
         }
         printf(ret == l_True ? "SATISFIABLE\n"
                              : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
+        writeStatsJson(S, stats_json);
         if (res != NULL) {
             if (ret == l_True) {
                 fprintf(res, "SAT\n");
-                for (int i = 0; i < S.nVars(); i++)
+                for (int i = 0; i < input_vars; i++)
                     if (S.model[i] != l_Undef)
                         fprintf(res, "%s%s%d", (i == 0) ? "" : " ",
                                 (S.model[i] == l_True) ? "" : "-", i + 1);
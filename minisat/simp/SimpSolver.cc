@@ -33,6 +33,25 @@ static BoolOption opt_use_asymm(_cat, "asymm", "Shrink clauses by asymmetric bra
 static BoolOption opt_use_rcheck(_cat, "rcheck", "Check if a clause is already implied. (costly)",
                                  false);
 static BoolOption opt_use_elim(_cat, "elim", "Perform variable elimination.", true);
+static BoolOption opt_use_bce(_cat, "bce", "Perform blocked clause elimination.", false);
+static BoolOption opt_use_cce(
+    _cat, "cce", "Perform covered clause elimination (implies blocked clause elimination).", false);
+static IntOption opt_cover_lim(_cat, "cce-lim",
+                               "Do not extend a clause by covered literals beyond this size.", 100,
+                               IntRange(0, INT32_MAX));
+static BoolOption opt_use_bva(_cat, "bva", "Perform bounded variable addition.", false);
+static IntOption opt_bva_lim(
+    _cat, "bva-lim",
+    "Limit on the number of clauses visited by bounded variable addition (in thousands).", 100000,
+    IntRange(0, INT32_MAX));
+static BoolOption opt_use_xor(
+    _cat, "xor", "Recover XOR constraints and propagate them by Gauss-Jordan elimination.", false);
+static IntOption opt_xor_lim(_cat, "xor-lim",
+                             "Do not recover XOR constraints over more variables than this.", 6,
+                             IntRange(3, 12));
+static IntOption opt_xor_cols(_cat, "xor-cols",
+                              "Do not build Gauss-Jordan matrices over more variables than this.",
+                              4096, IntRange(0, INT32_MAX));
 static IntOption opt_grow(_cat, "grow",
                           "Allow a variable elimination step to grow by a number of clauses.", 0);
 static IntOption opt_clause_lim(_cat, "cl-lim",
@@ -59,16 +78,33 @@ SimpSolver::SimpSolver()
       use_asymm(opt_use_asymm),
       use_rcheck(opt_use_rcheck),
       use_elim(opt_use_elim),
+      use_bce(opt_use_bce),
+      use_cce(opt_use_cce),
+      cover_lim(opt_cover_lim),
+      use_bva(opt_use_bva),
+      bva_lim((int64_t)opt_bva_lim * 1000),
+      use_xor(opt_use_xor),
+      xor_lim(opt_xor_lim),
+      xor_cols(opt_xor_cols),
       extend_model(true),
       merges(0),
       asymm_lits(0),
       eliminated_vars(0),
+      blocked_clauses(0),
+      covered_clauses(0),
+      bva_vars(0),
+      bva_removed(0),
+      reintroduced_clauses(0),
+      xor_constraints(0),
       elimorder(1),
       use_simplification(true),
       occurs(ClauseDeleted(ca)),
       elim_heap(ElimLt(n_occ)),
+      elim_dead(0),
       bwdsub_assigns(0),
-      n_touched(0)
+      n_touched(0),
+      xors_recovered(false),
+      gauss(NULL)
 {
     vec<Lit> dummy(1, lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -86,6 +122,7 @@ Var SimpSolver::newVar(lbool upol, bool dvar)
 
     frozen.insert(v, (char)false);
     eliminated.insert(v, (char)false);
+    witness.growTo(v + 1);
 
     if (use_simplification) {
         n_occ.insert(mkLit(v), 0);
@@ -99,6 +136,10 @@ Var SimpSolver::newVar(lbool upol, bool dvar)
 
 void SimpSolver::releaseVar(Lit l)
 {
+    add_tmp.clear();
+    add_tmp.push(l);
+    if (!reintroduce(add_tmp))
+        return;
     assert(!isEliminated(var(l)));
     if (!use_simplification && var(l) >= max_simp_var)
         // Note: Guarantees that no references to this variable is
@@ -116,12 +157,14 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
     do_simp &= use_simplification;
 
+    // Assumptions over eliminated variables need their clauses back:
+    if (!reintroduce(assumptions))
+        return l_False;
+
     if (do_simp) {
         // Assumptions must be temporarily frozen to run variable elimination:
         for (int i = 0; i < assumptions.size(); i++) {
             Var v = var(assumptions[i]);
-
-            // If an assumption has been eliminated, remember it.
             assert(!isEliminated(v));
 
             if (!frozen[v]) {
@@ -151,6 +194,44 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 }
 
 bool SimpSolver::addClause_(vec<Lit>& ps)
+{
+    return reintroduce(ps) && addSimpClause(ps);
+}
+
+// Cardinality and pseudo-Boolean constraints are propagated by the solver directly, so their
+// variables must be kept (including the clauses they amount to, which are not seen by the
+// simplifications).
+bool SimpSolver::addAtMost_(vec<Lit>& ps, int k)
+{
+    if (!reintroduce(ps))
+        return false;
+    for (int i = 0; i < ps.size(); i++)
+        setFrozen(var(ps[i]), true);
+    return Solver::addAtMost_(ps, k);
+}
+
+bool SimpSolver::addAtLeast_(vec<Lit>& ps, int k)
+{
+    if (!reintroduce(ps))
+        return false;
+    for (int i = 0; i < ps.size(); i++)
+        setFrozen(var(ps[i]), true);
+    return Solver::addAtLeast_(ps, k);
+}
+
+bool SimpSolver::addPB_(vec<Lit>& ps, vec<int64_t>& ws, int64_t k)
+{
+    if (!reintroduce(ps))
+        return false;
+    for (int i = 0; i < ps.size(); i++)
+        setFrozen(var(ps[i]), true);
+    return Solver::addPB_(ps, ws, k);
+}
+
+// Add a clause without checking it against the elimination stack. Used for clauses produced by
+// simplification itself, which are implied by the current clause database (or only mention new
+// variables).
+bool SimpSolver::addSimpClause(vec<Lit>& ps)
 {
 #ifndef NDEBUG
     for (int i = 0; i < ps.size(); i++)
@@ -339,14 +420,15 @@ bool SimpSolver::implied(const vec<Lit>& c)
 // Backward subsumption + backward subsumption resolution
 bool SimpSolver::backwardSubsumptionCheck(bool verbose)
 {
+    MINISAT_PROFILE(prof, subsume);
     int cnt = 0;
     int subsumed = 0;
     int deleted_literals = 0;
     assert(decisionLevel() == 0);
 
     while (subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) {
-        // Empty subsumption queue and return immediately on user-interrupt:
-        if (asynch_interrupt) {
+        // Empty subsumption queue and return immediately on user-interrupt (or past the deadline):
+        if (!poll()) {
             subsumption_queue.clear();
             bwdsub_assigns = trail.size();
             break;
@@ -439,6 +521,7 @@ bool SimpSolver::asymm(Var v, CRef cr)
 
 bool SimpSolver::asymmVar(Var v)
 {
+    MINISAT_PROFILE(prof, asymm);
     assert(use_simplification);
 
     const vec<CRef>& cls = occurs.lookup(v);
@@ -483,8 +566,348 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c)
     elimclauses.push(c.size());
 }
 
+// Store the first 'size' literals of 'ps' with the literal 'x' first (the literal 'x' must be among
+// them):
+static void mkElimClause(vec<uint32_t>& elimclauses, Lit x, const vec<Lit>& ps, int size)
+{
+    elimclauses.push(toInt(x));
+    for (int i = 0; i < size; i++)
+        if (ps[i] != x)
+            elimclauses.push(toInt(ps[i]));
+    elimclauses.push(size);
+}
+
+// Check if the clause 'cr' is blocked, after extending it with covered literals if 'use_cce' is
+// set, and remove it in that case. A literal 'l' is covered if it occurs in every non-tautological
+// resolvent on some literal of the (extended) clause. The extension steps are stored on the
+// elimination stack before the blocked clause itself, so that 'extendModel()' first satisfies the
+// fully extended clause and then each of its prefixes in turn. Returns TRUE if the clause was
+// removed.
+bool SimpSolver::blockedClause(CRef cr)
+{
+    const Clause& c = ca[cr];
+    assert(c.mark() == 0);
+
+    for (int i = 0; i < c.size(); i++)
+        if (value(c[i]) != l_Undef)
+            return false;
+
+    cover_lits.clear();
+    cover_wits.clear();
+    cover_sizes.clear();
+    for (int i = 0; i < c.size(); i++) {
+        cover_lits.push(c[i]);
+        seen[var(c[i])] = 1 + sign(c[i]);
+    }
+
+    Lit blocking = lit_Undef;
+    for (bool changed = true; changed && blocking == lit_Undef;) {
+        changed = false;
+        for (int i = 0; i < cover_lits.size() && blocking == lit_Undef; i++) {
+            Lit l = cover_lits[i];
+            if (frozen[var(l)])
+                continue;
+
+            // Intersect the non-tautological resolution candidates on 'l':
+            bool blocked = true;
+            cover_tmp.clear();
+            const vec<CRef>& cs = occurs.lookup(var(l));
+            for (int j = 0; j < cs.size(); j++) {
+                if (cs[j] == cr)
+                    continue;
+                const Clause& d = ca[cs[j]];
+                bool resolves = false, taut = false;
+                for (int k = 0; k < d.size() && !taut; k++)
+                    if (d[k] == ~l)
+                        resolves = true;
+                    else if (seen[var(d[k])] == 1 + sign(~d[k]))
+                        taut = true;
+                if (!resolves || taut)
+                    continue;
+
+                if (blocked) {
+                    blocked = false;
+                    if (use_cce)
+                        for (int k = 0; k < d.size(); k++)
+                            if (d[k] != ~l && !seen[var(d[k])] && value(d[k]) == l_Undef)
+                                cover_tmp.push(d[k]);
+                } else {
+                    int m, n;
+                    for (m = n = 0; m < cover_tmp.size(); m++)
+                        if (find(d, cover_tmp[m]))
+                            cover_tmp[n++] = cover_tmp[m];
+                    cover_tmp.shrink(m - n);
+                }
+
+                if (cover_tmp.size() == 0)
+                    break;
+            }
+
+            if (blocked)
+                blocking = l;
+            else if (cover_tmp.size() > 0 && cover_lits.size() + cover_tmp.size() <= cover_lim) {
+                cover_wits.push(l);
+                cover_sizes.push(cover_lits.size());
+                for (int j = 0; j < cover_tmp.size(); j++) {
+                    cover_lits.push(cover_tmp[j]);
+                    seen[var(cover_tmp[j])] = 1 + sign(cover_tmp[j]);
+                }
+                changed = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < cover_lits.size(); i++)
+        seen[var(cover_lits[i])] = 0;
+
+    if (blocking == lit_Undef)
+        return false;
+
+    for (int i = 0; i < cover_wits.size(); i++) {
+        mkElimClause(elimclauses, cover_wits[i], cover_lits, cover_sizes[i]);
+        witness[var(cover_wits[i])].push(elimclauses.size() - 1);
+    }
+    mkElimClause(elimclauses, blocking, cover_lits, cover_lits.size());
+    witness[var(blocking)].push(elimclauses.size() - 1);
+
+    if (cover_wits.size() > 0)
+        covered_clauses++;
+    else
+        blocked_clauses++;
+    removeClause(cr);
+
+    return true;
+}
+
+// Blocked (or covered) clause elimination for the clauses containing touched variables.
+void SimpSolver::blockedElim()
+{
+    MINISAT_PROFILE(prof, blocked);
+    vec<CRef> cands;
+    for (Var v = 0; v < nVars(); v++)
+        if (touched[v] && !frozen[v] && !isEliminated(v) && value(v) == l_Undef) {
+            const vec<CRef>& cs = occurs.lookup(v);
+            for (int j = 0; j < cs.size(); j++)
+                if (ca[cs[j]].mark() == 0) {
+                    ca[cs[j]].mark(2);
+                    cands.push(cs[j]);
+                }
+        }
+
+    for (int i = 0; i < cands.size(); i++)
+        ca[cands[i]].mark(0);
+
+    for (int i = 0; i < cands.size() && poll(); i++)
+        if (ca[cands[i]].mark() == 0)
+            blockedClause(cands[i]);
+}
+
+// Add to 'bva_pairs' every literal 'x' such that the clause 'cr' with 'l' replaced by 'x' is in the
+// clause database, paired with the index 'cls'.
+void SimpSolver::bvaMatches(CRef cr, Lit l, int cls, int64_t& steps)
+{
+    const Clause& c = ca[cr];
+    Lit lmin = lit_Undef;
+    for (int i = 0; i < c.size(); i++)
+        if (c[i] != l) {
+            seen[var(c[i])] = 1 + sign(c[i]);
+            if (lmin == lit_Undef || n_occ[c[i]] < n_occ[lmin])
+                lmin = c[i];
+        }
+
+    const vec<CRef>& ds = occurs.lookup(var(lmin));
+    steps += ds.size();
+    for (int j = 0; j < ds.size(); j++) {
+        const Clause& d = ca[ds[j]];
+        if (ds[j] == cr || d.size() != c.size())
+            continue;
+
+        Lit x = lit_Undef;
+        int k;
+        for (k = 0; k < d.size(); k++)
+            if (seen[var(d[k])] != 1 + sign(d[k])) {
+                if (x != lit_Undef)
+                    break;
+                x = d[k];
+            }
+        if (k == d.size() && x != lit_Undef && var(x) != var(l) && value(x) == l_Undef &&
+            !find(bva_lits, x))
+            bva_pairs.push(BvaPair(x, cls));
+    }
+
+    for (int i = 0; i < c.size(); i++)
+        seen[var(c[i])] = 0;
+}
+
+// Return the clause 'cr' with 'l' replaced by 'x' (or 'CRef_Undef' if it is not in the database).
+CRef SimpSolver::bvaFind(CRef cr, Lit l, Lit x)
+{
+    const Clause& c = ca[cr];
+    for (int i = 0; i < c.size(); i++)
+        if (c[i] != l)
+            seen[var(c[i])] = 1 + sign(c[i]);
+    seen[var(x)] = 1 + sign(x);
+
+    CRef found = CRef_Undef;
+    const vec<CRef>& ds = occurs.lookup(var(x));
+    for (int j = 0; j < ds.size() && found == CRef_Undef; j++) {
+        const Clause& d = ca[ds[j]];
+        int k;
+        for (k = 0; k < d.size() && seen[var(d[k])] == 1 + sign(d[k]); k++)
+            ;
+        if (d.size() == c.size() && k == d.size())
+            found = ds[j];
+    }
+
+    for (int i = 0; i < c.size(); i++)
+        seen[var(c[i])] = 0;
+    seen[var(x)] = 0;
+
+    return found;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  bva : [void]  ->  [bool]
+|  
+|  Description:
+|    Bounded variable addition (SimpleBVA). Starting from the literal 'l' with most occurrences,
+|    greedily collect a set of literals 'L' and clauses 'C' such that '(C \ {l}) + {x}' is in the
+|    database for all 'x' in 'L' and all clauses in 'C', as long as replacing these '|L| * |C|'
+|    clauses by '|L| + |C|' clauses reduces the database further. The replacement introduces a
+|    fresh variable 'y', with the clauses 'x + y' for 'x' in 'L' and '(C \ {l}) + ~y' for 'C' in
+|    'C'. Resolving on 'y' gives back the original clauses, so no model extension is needed.
+|  
+|    Returns FALSE if the clause database was found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::bva()
+{
+    MINISAT_PROFILE(prof, bva);
+    BvaLt lt(n_occ);
+    Heap<Lit, BvaLt, MkIndexLit> queue(lt);
+    for (Var v = 0; v < nVars(); v++)
+        if (!isEliminated(v) && value(v) == l_Undef)
+            for (int s = 0; s < 2; s++)
+                if (n_occ[mkLit(v, s)] >= 2)
+                    queue.insert(mkLit(v, s));
+
+    vec<CRef> rm;
+    vec<Lit> rest;
+    vec<int> rest_ends;
+    int64_t steps = 0;
+    while (!queue.empty() && steps < bva_lim && poll()) {
+        Lit l = queue.removeMin();
+        if (value(l) != l_Undef || isEliminated(var(l)))
+            continue;
+
+        bva_lits.clear();
+        bva_cls.clear();
+        bva_lits.push(l);
+        const vec<CRef>& cs = occurs.lookup(var(l));
+        for (int i = 0; i < cs.size(); i++) {
+            const Clause& c = ca[cs[i]];
+            int j;
+            for (j = 0; j < c.size() && value(c[j]) == l_Undef; j++)
+                ;
+            if (j == c.size() && find(c, l))
+                bva_cls.push(cs[i]);
+        }
+
+        for (;;) {
+            bva_pairs.clear();
+            for (int i = 0; i < bva_cls.size(); i++)
+                bvaMatches(bva_cls[i], l, i, steps);
+            sort(bva_pairs);
+
+            // Find the literal matched with the largest number of clauses:
+            Lit best = lit_Undef;
+            int best_n = 0;
+            for (int i = 0, j; i < bva_pairs.size(); i = j) {
+                int n = 0;
+                for (j = i; j < bva_pairs.size() && bva_pairs[j].lit == bva_pairs[i].lit; j++)
+                    if (j == i || bva_pairs[j].cls != bva_pairs[j - 1].cls)
+                        n++;
+                if (n > best_n)
+                    best = bva_pairs[i].lit, best_n = n;
+            }
+
+            int a = bva_lits.size(), b = bva_cls.size();
+            if (best == lit_Undef || (a + 1) * best_n - (a + 1) - best_n <= a * b - a - b)
+                break;
+
+            bva_lits.push(best);
+            int k = 0;
+            for (int i = 0; i < bva_pairs.size(); i++)
+                if (bva_pairs[i].lit == best &&
+                    (k == 0 || bva_cls[k - 1] != bva_cls[bva_pairs[i].cls]))
+                    bva_cls[k++] = bva_cls[bva_pairs[i].cls];
+            bva_cls.shrink(bva_cls.size() - k);
+        }
+
+        int a = bva_lits.size(), b = bva_cls.size();
+        if (a * b - a - b <= 0)
+            continue;
+
+        // Collect the clauses to replace:
+        rm.clear();
+        rest.clear();
+        rest_ends.clear();
+        for (int i = 0; i < bva_cls.size(); i++) {
+            const Clause& c = ca[bva_cls[i]];
+            rm.push(bva_cls[i]);
+            for (int j = 1; j < bva_lits.size(); j++) {
+                CRef d = bvaFind(bva_cls[i], l, bva_lits[j]);
+                assert(d != CRef_Undef);
+                rm.push(d);
+            }
+            for (int j = 0; j < c.size(); j++)
+                if (c[j] != l)
+                    rest.push(c[j]);
+            rest_ends.push(rest.size());
+        }
+        for (int i = 0; i < rm.size(); i++)
+            if (!ca[rm[i]].mark())
+                removeClause(rm[i]);
+
+        // Introduce the new variable:
+        Lit y = mkLit(newVar());
+        bva_vars++;
+        bva_removed += a * b - a - b;
+        for (int i = 0; i < bva_lits.size(); i++) {
+            add_tmp.clear();
+            add_tmp.push(bva_lits[i]);
+            add_tmp.push(y);
+            if (!addSimpClause(add_tmp))
+                return false;
+        }
+        vec<Lit> ps;
+        for (int i = 0, n = 0; i < rest_ends.size(); i++) {
+            ps.clear();
+            ps.push(~y);
+            for (; n < rest_ends[i]; n++)
+                ps.push(rest[n]);
+            if (!addSimpClause(ps))
+                return false;
+        }
+
+        // Update the queue with the changed occurrence counts:
+        for (int i = 0; i < bva_lits.size(); i++)
+            rest.push(bva_lits[i]);
+        rest.push(y);
+        rest.push(~y);
+        for (int i = 0; i < rest.size(); i++)
+            if (queue.inHeap(rest[i]))
+                queue.update(rest[i]);
+            else if (n_occ[rest[i]] >= 2 && value(rest[i]) == l_Undef)
+                queue.insert(rest[i]);
+    }
+
+    return true;
+}
+
 bool SimpSolver::eliminateVar(Var v)
 {
+    MINISAT_PROFILE(prof, elim_var);
     assert(!frozen[v]);
     assert(!isEliminated(v));
     assert(value(v) == l_Undef);
@@ -513,15 +936,21 @@ bool SimpSolver::eliminateVar(Var v)
     setDecisionVar(v, false);
     eliminated_vars++;
 
-    if (pos.size() > neg.size()) {
-        for (int i = 0; i < neg.size(); i++)
-            mkElimClause(elimclauses, v, ca[neg[i]]);
-        mkElimClause(elimclauses, mkLit(v));
-    } else {
-        for (int i = 0; i < pos.size(); i++)
-            mkElimClause(elimclauses, v, ca[pos[i]]);
-        mkElimClause(elimclauses, ~mkLit(v));
+    // NOTE: only the clauses of the smaller side are needed to extend a model (the larger side is
+    // satisfied by the default value stored last), but both sides are needed to reintroduce 'v'.
+    // The larger side goes first, as its entries never change the model:
+    vec<CRef>& small = pos.size() > neg.size() ? neg : pos;
+    vec<CRef>& large = pos.size() > neg.size() ? pos : neg;
+    for (int i = 0; i < large.size(); i++) {
+        mkElimClause(elimclauses, v, ca[large[i]]);
+        witness[v].push(elimclauses.size() - 1);
     }
+    for (int i = 0; i < small.size(); i++) {
+        mkElimClause(elimclauses, v, ca[small[i]]);
+        witness[v].push(elimclauses.size() - 1);
+    }
+    mkElimClause(elimclauses, mkLit(v, &small == &pos));
+    witness[v].push(elimclauses.size() - 1);
 
     for (int i = 0; i < cls.size(); i++)
         removeClause(cls[i]);
@@ -530,7 +959,7 @@ bool SimpSolver::eliminateVar(Var v)
     vec<Lit>& resolvent = add_tmp;
     for (int i = 0; i < pos.size(); i++)
         for (int j = 0; j < neg.size(); j++)
-            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
+            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addSimpClause(resolvent))
                 return false;
 
     // Free occurs list for this variable:
@@ -588,21 +1017,259 @@ void SimpSolver::extendModel()
                 goto next;
 
         x = toLit(elimclauses[i]);
-        model[var(x)] = lbool(!sign(x));
+        if (x != lit_Undef) // (not an entry taken off the stack by 'reintroduce()')
+            model[var(x)] = lbool(!sign(x));
     next:;
     }
 }
 
+/*_________________________________________________________________________________________________
+|
+|  reintroduce : (ps : const vec<Lit>&)  ->  [bool]
+|  
+|  Description:
+|    Prepare for constraining the variables of 'ps' (a new clause or the assumptions). An entry of
+|    the elimination stack is only valid as long as its witness variable is not constrained any
+|    further, so every entry whose witness is one of these variables is taken off the stack and its
+|    clause is added back. The variables of the clauses brought back are treated the same way,
+|    until a fixpoint is reached. Eliminated variables among them become regular variables again
+|    (and may be eliminated again later). This makes it unnecessary to freeze variables that are
+|    going to be used incrementally.
+|
+|    The entries are found through 'witness', and only marked as taken off (their witness literal
+|    is replaced by 'lit_Undef', which 'extendModel()' skips). The stack is compacted once such
+|    entries take up half of it.
+|  
+|    Returns FALSE if the clause database was found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::reintroduce(const vec<Lit>& ps)
+{
+    int i, j;
+    for (i = 0; i < ps.size() && witness[var(ps[i])].size() == 0; i++)
+        ;
+    if (i == ps.size())
+        return ok;
+
+    // Take off the entries of the marked witnesses (the variables of 'ps' and of the clauses
+    // brought back), remembering the clauses to add back (unit entries only hold the default
+    // value of an eliminated variable):
+    vec<Var> marked;
+    for (i = 0; i < ps.size(); i++)
+        if (!seen[var(ps[i])]) {
+            seen[var(ps[i])] = 1;
+            marked.push(var(ps[i]));
+        }
+    vec<Lit> back;
+    vec<int> back_ends;
+    for (int k = 0; k < marked.size(); k++) {
+        vec<int>& ends = witness[marked[k]];
+        for (i = 0; i < ends.size(); i++) {
+            int first = ends[i] - elimclauses[ends[i]];
+            for (j = first; j < ends[i]; j++) {
+                Var v = var(toLit(elimclauses[j]));
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    marked.push(v);
+                }
+            }
+            if (elimclauses[ends[i]] > 1) {
+                for (j = first; j < ends[i]; j++)
+                    back.push(toLit(elimclauses[j]));
+                back_ends.push(back.size());
+            }
+            elimclauses[first] = toInt(lit_Undef);
+            elim_dead += elimclauses[ends[i]] + 1;
+        }
+        ends.clear(true);
+    }
+
+    for (i = 0; i < marked.size(); i++) {
+        Var v = marked[i];
+        seen[v] = 0;
+        if (isEliminated(v)) {
+            eliminated[v] = false;
+            setDecisionVar(v, true);
+            if (use_simplification)
+                updateElimHeap(v);
+        }
+    }
+
+    if (elim_dead > elimclauses.size() / 2)
+        compactElimClauses();
+
+    vec<Lit> clause;
+    for (i = j = 0; i < back_ends.size(); i++) {
+        clause.clear();
+        for (; j < back_ends[i]; j++)
+            clause.push(back[j]);
+        reintroduced_clauses++;
+        if (!addSimpClause(clause))
+            return false;
+    }
+
+    return ok;
+}
+
+// Remove the entries taken off by 'reintroduce()' from the elimination stack (and move the
+// positions in 'witness' along).
+void SimpSolver::compactElimClauses()
+{
+    vec<int> ends;
+    for (int i = elimclauses.size() - 1; i > 0; i -= elimclauses[i] + 1) {
+        ends.push(i);
+        Lit x = toLit(elimclauses[i - elimclauses[i]]);
+        if (x != lit_Undef)
+            witness[var(x)].clear();
+    }
+
+    int n = 0;
+    for (int i = ends.size() - 1; i >= 0; i--) {
+        int first = ends[i] - elimclauses[ends[i]];
+        Lit x = toLit(elimclauses[first]);
+        if (x == lit_Undef)
+            continue;
+        for (int j = first; j <= ends[i]; j++)
+            elimclauses[n++] = elimclauses[j];
+        witness[var(x)].push(n - 1);
+    }
+    elimclauses.shrink(elimclauses.size() - n);
+    elim_dead = 0;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  recoverXors : [void]  ->  [void]
+|  
+|  Description:
+|    Recover XOR constraints from their direct encoding: a group of clauses over the same 'k'
+|    variables (3 <= k <= 'xor_lim') containing all '2^(k-1)' clauses with an even (odd) number of
+|    negative literals encodes 'x1 ^ ... ^ xk = 1' ('= 0'). The constraints are handed over to a
+|    Gauss-Jordan engine, grouped by the variables they share. A group with a single constraint is
+|    left to the clauses, which propagate it just as well, and so is a group over more than
+|    'xor_cols' variables. The clauses are kept, and the variables handed over are frozen.
+|________________________________________________________________________________________________@*/
+static int findRoot(vec<int>& parent, int x)
+{
+    while (parent[x] != x)
+        x = parent[x] = parent[parent[x]];
+    return x;
+}
+
+void SimpSolver::recoverXors()
+{
+    MINISAT_PROFILE(prof, xors);
+    // Sort the candidate clauses by their variables:
+    vec<Lit> lits;
+    vec<int> start;
+    vec<int> cands;
+    start.push(0);
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        if (c.mark() != 0 || c.size() < 3 || c.size() > xor_lim)
+            continue;
+        int s = lits.size();
+        for (int j = 0; j < c.size(); j++)
+            lits.push(c[j]);
+        sort(&lits[s], c.size());
+        cands.push(start.size() - 1);
+        start.push(lits.size());
+    }
+    XorLt lt(lits, start);
+    sort(cands, lt);
+
+    // Find the groups of clauses encoding XOR constraints:
+    vec<Var> xs;
+    vec<int> xs_ends;
+    vec<char> xs_rhs;
+    vec<char> pattern;
+    for (int i = 0, j; i < cands.size(); i = j) {
+        for (j = i + 1; j < cands.size() && !lt(cands[i], cands[j]); j++)
+            ;
+        int k = start[cands[i] + 1] - start[cands[i]];
+        if (j - i < 1 << (k - 1))
+            continue;
+
+        int n[2] = {0, 0};
+        pattern.clear();
+        pattern.growTo(1 << k, 0);
+        for (int l = i; l < j; l++) {
+            int mask = 0, neg = 0;
+            for (int t = 0; t < k; t++)
+                if (sign(lits[start[cands[l]] + t]))
+                    mask |= 1 << t, neg++;
+            if (!pattern[mask]) {
+                pattern[mask] = 1;
+                n[neg & 1]++;
+            }
+        }
+
+        for (int q = 0; q < 2; q++)
+            if (n[q] == 1 << (k - 1)) {
+                for (int t = 0; t < k; t++)
+                    xs.push(var(lits[start[cands[i]] + t]));
+                xs_ends.push(xs.size());
+                xs_rhs.push(q == 0);
+            }
+    }
+
+    // Group the constraints by shared variables:
+    vec<int> parent(nVars());
+    for (int i = 0; i < parent.size(); i++)
+        parent[i] = i;
+    for (int i = 0, s = 0; i < xs_ends.size(); s = xs_ends[i++])
+        for (int j = s + 1; j < xs_ends[i]; j++)
+            parent[findRoot(parent, xs[j])] = findRoot(parent, xs[s]);
+
+    vec<int> n_xors(nVars(), 0);
+    vec<int> n_vars(nVars(), 0);
+    for (int i = 0; i < xs.size(); i++)
+        if (!seen[xs[i]]) {
+            seen[xs[i]] = 1;
+            n_vars[findRoot(parent, xs[i])]++;
+        }
+    for (int i = 0; i < xs.size(); i++)
+        seen[xs[i]] = 0;
+    for (int i = 0, s = 0; i < xs_ends.size(); s = xs_ends[i++])
+        n_xors[findRoot(parent, xs[s])]++;
+
+    vec<Var> vs;
+    for (int i = 0, s = 0; i < xs_ends.size(); s = xs_ends[i++]) {
+        int r = findRoot(parent, xs[s]);
+        if (n_xors[r] < 2 || n_vars[r] > xor_cols)
+            continue;
+        if (gauss == NULL) {
+            gauss = new Gauss(*this);
+            addPropagator(gauss);
+        }
+        vs.clear();
+        for (int j = s; j < xs_ends[i]; j++) {
+            vs.push(xs[j]);
+            setFrozen(xs[j], true);
+        }
+        gauss->addXor(vs, xs_rhs[i]);
+        xor_constraints++;
+    }
+}
+
 bool SimpSolver::eliminate(bool turn_off_elim)
 {
+    MINISAT_PROFILE(prof, eliminate);
     if (!simplify())
         return false;
     else if (!use_simplification)
         return true;
 
+    if (use_xor && !xors_recovered) {
+        xors_recovered = true;
+        recoverXors();
+    }
+
     // Main simplification loop:
     //
+    bool bva_pending = use_bva;
     while (n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0) {
+        if (use_bce || use_cce)
+            blockedElim();
         gatherTouchedClauses();
         // printf("  ## (time = %6.2f s) BWD-SUB: queue = %d, trail = %d\n", cpuTime(), subsumption_queue.size(), trail.size() - bwdsub_assigns);
         if ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) &&
@@ -611,8 +1278,8 @@ bool SimpSolver::eliminate(bool turn_off_elim)
             goto cleanup;
         }
 
-        // Empty elim_heap and return immediately on user-interrupt:
-        if (asynch_interrupt) {
+        // Empty elim_heap and return immediately on user-interrupt (or past the deadline):
+        if (!poll()) {
             assert(bwdsub_assigns == trail.size());
             assert(subsumption_queue.size() == 0);
             assert(n_touched == 0);
@@ -620,11 +1287,20 @@ bool SimpSolver::eliminate(bool turn_off_elim)
             goto cleanup;
         }
 
+        if (bva_pending) {
+            bva_pending = false;
+            if (!bva()) {
+                ok = false;
+                goto cleanup;
+            }
+            continue;
+        }
+
         // printf("  ## (time = %6.2f s) ELIM: vars = %d\n", cpuTime(), elim_heap.size());
         for (int cnt = 0; !elim_heap.empty(); cnt++) {
             Var elim = elim_heap.removeMin();
 
-            if (asynch_interrupt)
+            if (!poll())
                 break;
 
             if (isEliminated(elim) || value(elim) != l_Undef)
@@ -679,6 +1355,9 @@ cleanup:
         checkGarbage();
     }
 
+    if (verbosity >= 1 && xor_constraints > 0)
+        printf("|  XOR constraints:        %10d                                         |\n",
+               xor_constraints);
     if (verbosity >= 1 && elimclauses.size() > 0)
         printf("|  Eliminated clauses:     %10.2f Mb                                      |\n",
                double(elimclauses.size() * sizeof(uint32_t)) / (1024 * 1024));
@@ -721,6 +1400,7 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 
 void SimpSolver::garbageCollect()
 {
+    MINISAT_PROFILE(prof, gc);
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
@@ -734,3 +1414,29 @@ void SimpSolver::garbageCollect()
                ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
+
+void SimpSolver::statsJson(FILE* f) const
+{
+    Solver::statsJson(f);
+    fprintf(f, ", \"eliminated_vars\": %d, \"merges\": %d, \"asymm_lits\": %d", eliminated_vars,
+            merges, asymm_lits);
+    fprintf(f, ", \"blocked_clauses\": %d, \"covered_clauses\": %d", blocked_clauses,
+            covered_clauses);
+    fprintf(f, ", \"bva_vars\": %d, \"bva_removed\": %d", bva_vars, bva_removed);
+    fprintf(f, ", \"reintroduced_clauses\": %d, \"xor_constraints\": %d", reintroduced_clauses,
+            xor_constraints);
+}
+
+void SimpSolver::memUse(vec<MemUse>& out) const
+{
+    Solver::memUse(out);
+    addMemUse(out, "occurs", occurs.bytes());
+    addMemUse(out, "elimclauses", bytes(elimclauses));
+    uint64_t witness_bytes = bytes(witness);
+    for (int i = 0; i < witness.size(); i++)
+        witness_bytes += bytes(witness[i]);
+    addMemUse(out, "simp_var_arrays", bytes(touched) + bytes(n_occ) + bytes(frozen) +
+                                          bytes(eliminated) + witness_bytes);
+    addMemUse(out, "elim_heap", elim_heap.bytes());
+    addMemUse(out, "subsumption_queue", subsumption_queue.bytes());
+}
@@ -23,6 +23,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "minisat/mtl/Queue.h"
 #include "minisat/core/Solver.h"
+#include "minisat/core/Gauss.h"
 
 
 namespace Minisat {
@@ -47,13 +48,20 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q);        // Add a binary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r, Lit s); // Add a quaternary clause to the solver. 
-    bool    addClause_(      vec<Lit>& ps);
+    bool    addClause_(      vec<Lit>& ps);      // NOTE: clauses over eliminated variables are brought back first.
+    bool    addAtMost (const vec<Lit>& ps, int k); // Add the constraint 'at most k of ps are true'.
+    bool    addAtLeast(const vec<Lit>& ps, int k); // Add the constraint 'at least k of ps are true'.
+    bool    addAtMost_(      vec<Lit>& ps, int k); // NOTE: the variables are brought back and frozen first.
+    bool    addAtLeast_(     vec<Lit>& ps, int k); // NOTE: the variables are brought back and frozen first.
+    bool    addPB     (const vec<Lit>& ps, const vec<int64_t>& ws, int64_t k); // Add the constraint 'ws[0]*ps[0] + ... >= k'.
+    bool    addPB_    (      vec<Lit>& ps,       vec<int64_t>& ws, int64_t k); // NOTE: the variables are brought back and frozen first.
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
     // 
     void    setFrozen (Var v, bool b); // If a variable is frozen it will not be eliminated.
     bool    isEliminated(Var v) const;
+    bool    reintroduce(const vec<Lit>& ps); // Bring back eliminated clauses that could be affected by constraining 'ps'.
 
     // Alternative freeze interface (may replace 'setFrozen()'):
     void    freezeVar (Var v);         // Freeze one variable so it will not be eliminated.
@@ -96,6 +104,16 @@ class SimpSolver : public Solver {
     bool    use_asymm;         // Shrink clauses by asymmetric branching.
     bool    use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
     bool    use_elim;          // Perform variable elimination.
+    bool    use_bce;           // Perform blocked clause elimination. NOTE: as with eliminated variables, adding a
+                               // clause (or assumption) over the witness of a removed clause brings it back first
+                               // (see 'reintroduce()'), so such variables need not be frozen.
+    bool    use_cce;           // Perform covered clause elimination (implies 'use_bce').
+    int     cover_lim;         // Do not extend a clause by covered literals beyond this size.
+    bool    use_bva;           // Perform bounded variable addition.
+    int64_t bva_lim;           // Limit on the number of clauses visited by one round of bounded variable addition.
+    bool    use_xor;           // Recover XOR constraints and propagate them by Gauss-Jordan elimination.
+    int     xor_lim;           // Do not recover XOR constraints over more variables than this.
+    int     xor_cols;          // Do not build Gauss-Jordan matrices over more variables than this.
     bool    extend_model;      // Flag to indicate whether the user needs to look at the full model.
 
     // Statistics:
@@ -103,6 +121,12 @@ class SimpSolver : public Solver {
     int     merges;
     int     asymm_lits;
     int     eliminated_vars;
+    int     blocked_clauses;
+    int     covered_clauses;
+    int     bva_vars;
+    int     bva_removed;
+    int     reintroduced_clauses;
+    int     xor_constraints;
 
  protected:
 
@@ -124,6 +148,31 @@ class SimpSolver : public Solver {
         //     return c_x < c_y || c_x == c_y && x < y; }
     };
 
+    struct BvaLt {
+        const LMap<int>& n_occ;
+        explicit BvaLt(const LMap<int>& no) : n_occ(no) {}
+        bool operator()(Lit x, Lit y) const { return n_occ[x] > n_occ[y]; }
+    };
+
+    struct BvaPair {
+        Lit lit; int cls;
+        BvaPair() {}
+        BvaPair(Lit l, int c) : lit(l), cls(c) {}
+        bool operator<(const BvaPair& o) const { return lit < o.lit || (lit == o.lit && cls < o.cls); }
+    };
+
+    struct XorLt {
+        const vec<Lit>& lits; const vec<int>& start;
+        XorLt(const vec<Lit>& l, const vec<int>& s) : lits(l), start(s) {}
+        bool operator()(int x, int y) const {
+            int sx = start[x+1] - start[x], sy = start[y+1] - start[y];
+            if (sx != sy) return sx < sy;
+            for (int i = 0; i < sx; i++)
+                if (var(lits[start[x]+i]) != var(lits[start[y]+i]))
+                    return var(lits[start[x]+i]) < var(lits[start[y]+i]);
+            return false; }
+    };
+
     struct ClauseDeleted {
         const ClauseAllocator& ca;
         explicit ClauseDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
@@ -144,12 +193,23 @@ class SimpSolver : public Solver {
     VMap<char>          frozen;
     vec<Var>            frozen_vars;
     VMap<char>          eliminated;
+    vec<vec<int> >      witness;             // The entries of 'elimclauses' (positions of their size fields) by witness variable.
+    int                 elim_dead;           // Words of 'elimclauses' in entries taken off by 'reintroduce()'.
     int                 bwdsub_assigns;
     int                 n_touched;
+    bool                xors_recovered;
+    Gauss*              gauss;               // The Gauss-Jordan engine for recovered XOR constraints (owned by 'Solver').
 
     // Temporaries:
     //
     CRef                bwdsub_tmpunit;
+    vec<Lit>            cover_lits;
+    vec<Lit>            cover_wits;
+    vec<int>            cover_sizes;
+    vec<Lit>            cover_tmp;
+    vec<Lit>            bva_lits;
+    vec<CRef>           bva_cls;
+    vec<BvaPair>        bva_pairs;
 
     // Main internal methods:
     //
@@ -162,12 +222,22 @@ class SimpSolver : public Solver {
     bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
     bool          backwardSubsumptionCheck (bool verbose = false);
     bool          eliminateVar             (Var v);
+    bool          addSimpClause            (vec<Lit>& ps);
+    void          blockedElim              ();
+    bool          blockedClause            (CRef cr);
+    bool          bva                      ();
+    void          bvaMatches               (CRef cr, Lit l, int cls, int64_t& steps);
+    CRef          bvaFind                  (CRef cr, Lit l, Lit x);
+    void          recoverXors              ();
     void          extendModel              ();
+    void          compactElimClauses       ();
 
     void          removeClause             (CRef cr);
     bool          strengthenClause         (CRef cr, Lit l);
     bool          implied                  (const vec<Lit>& c);
     void          relocAll                 (ClauseAllocator& to);
+    virtual void  statsJson                (FILE* f) const;
+    virtual void  memUse                   (vec<MemUse>& out) const;
 };
 
 
@@ -189,6 +259,9 @@ inline bool SimpSolver::addClause    (Lit p)                 { add_tmp.clear();
 inline bool SimpSolver::addClause    (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
 inline bool SimpSolver::addClause    (Lit p, Lit q, Lit r, Lit s){ add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); add_tmp.push(s); return addClause_(add_tmp); }
+inline bool SimpSolver::addAtMost    (const vec<Lit>& ps, int k){ ps.copyTo(add_tmp); return addAtMost_(add_tmp, k); }
+inline bool SimpSolver::addAtLeast   (const vec<Lit>& ps, int k){ ps.copyTo(add_tmp); return addAtLeast_(add_tmp, k); }
+inline bool SimpSolver::addPB        (const vec<Lit>& ps, const vec<int64_t>& ws, int64_t k){ ps.copyTo(add_tmp); ws.copyTo(add_weights); return addPB_(add_tmp, add_weights, k); }
 inline void SimpSolver::setFrozen    (Var v, bool b) { frozen[v] = (char)b; if (use_simplification && !b) { updateElimHeap(v); } }
 
 inline void SimpSolver::freezeVar(Var v){
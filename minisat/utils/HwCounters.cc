@@ -0,0 +1,167 @@
+/***********************************************************************************[HwCounters.cc]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "minisat/utils/HwCounters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+using namespace Minisat;
+
+HwCounters::HwCounters()
+{
+    for (int i = 0; i < nevents; i++) {
+        fds[i] = -1;
+        pages[i] = NULL;
+    }
+}
+
+HwCounters::~HwCounters()
+{
+    close();
+}
+
+const char* HwCounters::name(int event)
+{
+    static const char* names[nevents] = {"cycles", "instructions", "cache_misses",
+                                         "branch_misses"};
+    return names[event];
+}
+
+#if defined(__linux__)
+
+static int openEvent(uint64_t config, int group)
+{
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(pe);
+    pe.config = config;
+    pe.disabled = group == -1; // (the leader starts the whole group)
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+    return syscall(__NR_perf_event_open, &pe, 0, -1, group, 0);
+}
+
+bool HwCounters::open()
+{
+    static const uint64_t configs[nevents] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                              PERF_COUNT_HW_CACHE_MISSES,
+                                              PERF_COUNT_HW_BRANCH_MISSES};
+    close();
+    for (int i = 0; i < nevents; i++)
+        if ((fds[i] = openEvent(configs[i], fds[0])) == -1) {
+            close();
+            return false;
+        }
+
+    // (the first page is all that is needed, for reading the counters without a system call)
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (int i = 0; i < nevents; i++)
+        if ((pages[i] = mmap(NULL, page_size, PROT_READ, MAP_SHARED, fds[i], 0)) == MAP_FAILED)
+            pages[i] = NULL;
+
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+// Read a counter with 'rdpmc' (see 'perf_event_open(2)'). Returns FALSE if that is not allowed, or
+// the event is not on a counter right now.
+static bool readPage(const void* page, uint64_t& out)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    const volatile perf_event_mmap_page* pc = (const volatile perf_event_mmap_page*)page;
+    uint32_t seq;
+    uint64_t count;
+    do {
+        seq = pc->lock;
+        __asm__ __volatile__("" ::: "memory");
+        uint32_t index = pc->index;
+        if (!pc->cap_user_rdpmc || index == 0)
+            return false;
+        int width = pc->pmc_width;
+        int64_t pmc = __rdpmc(index - 1);
+        pmc = (int64_t)((uint64_t)pmc << (64 - width)) >> (64 - width); // (sign extension)
+        count = pc->offset + pmc;
+        __asm__ __volatile__("" ::: "memory");
+    } while (pc->lock != seq);
+    out = count;
+    return true;
+#else
+    (void)page, (void)out;
+    return false;
+#endif
+}
+
+bool HwCounters::read(uint64_t* out) const
+{
+    int i = 0;
+    while (i < nevents && pages[i] != NULL && readPage(pages[i], out[i]))
+        i++;
+    if (i == nevents)
+        return true;
+
+    uint64_t buf[1 + nevents]; // (the number of events, followed by their values)
+    if (fds[0] == -1 || ::read(fds[0], buf, sizeof(buf)) != (ssize_t)sizeof(buf))
+        return false;
+    for (int i = 0; i < nevents; i++)
+        out[i] = buf[1 + i];
+    return true;
+}
+
+void HwCounters::close()
+{
+    long page_size = sysconf(_SC_PAGESIZE);
+    for (int i = nevents - 1; i >= 0; i--) {
+        if (pages[i] != NULL)
+            munmap(pages[i], page_size), pages[i] = NULL;
+        if (fds[i] != -1)
+            ::close(fds[i]), fds[i] = -1;
+    }
+}
+
+#else
+
+bool HwCounters::open()
+{
+    return false;
+}
+
+bool HwCounters::read(uint64_t*) const
+{
+    return false;
+}
+
+void HwCounters::close()
+{
+}
+
+#endif
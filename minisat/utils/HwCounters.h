@@ -0,0 +1,63 @@
+/************************************************************************************[HwCounters.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_HwCounters_h
+#define Minisat_HwCounters_h
+
+#include "minisat/mtl/IntTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// HwCounters -- hardware event counters of the calling thread (Linux 'perf_event_open()'):
+//
+// The events are opened as one group, so that they are always scheduled together. Only user-space
+// events are counted. Where the kernel allows it (on x86), the counters are read in user space by
+// 'rdpmc', using the page the kernel maps for each event; reads around short phases (like
+// propagation) then cost no system call, which would also disturb the caches and branch predictor
+// whose misses are being counted. Otherwise a single 'read()' returns all of them.
+
+class HwCounters
+{
+   public:
+    enum Event { cycles, instructions, cache_misses, branch_misses, nevents };
+
+    HwCounters();
+    ~HwCounters();
+
+    bool open(); // Open and start the counters. Returns FALSE if they are not available.
+    bool read(uint64_t* out) const; // Read the current value of each event into 'out'.
+    bool isOpen() const
+    {
+        return fds[0] != -1;
+    }
+    static const char* name(int event);
+
+   protected:
+    int fds[nevents];
+    void* pages[nevents]; // The page mapped for each event, or NULL.
+
+    void close();
+};
+
+//=================================================================================================
+} // namespace Minisat
+
+#endif
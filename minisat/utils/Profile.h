@@ -0,0 +1,218 @@
+/***************************************************************************************[Profile.h]
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Profile_h
+#define Minisat_Profile_h
+
+#include "minisat/mtl/IntTypes.h"
+#include "minisat/utils/HwCounters.h"
+#include "minisat/utils/System.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace Minisat {
+
+static inline uint64_t cpuTicks(void); // A cheap monotonic counter (the time-stamp counter on x86).
+
+//=================================================================================================
+// Profile -- time spent in each phase of the solver:
+//
+// Phases are timed by placing 'MINISAT_PROFILE(prof, phase)' at the top of the function (or block)
+// doing them. Nested phases are counted in both, so the times do not add up. Ticks are converted to
+// seconds at the rate observed since the profile was created. Compiling with 'MINISAT_NO_PROFILE'
+// removes the timers altogether. If hardware counters are opened ('openHw()'), their events are
+// attributed to the phases in the same way.
+
+class Profile
+{
+   public:
+    enum Phase {
+        propagate,
+        analyze,
+        minimize,
+        reduce,
+        simplify,
+        gc,
+        probe,
+        vivify,
+        walk,
+        eliminate, // (the phases below are the passes of 'SimpSolver')
+        subsume,
+        asymm,
+        elim_var,
+        blocked,
+        bva,
+        xors,
+        nphases
+    };
+
+    Profile();
+    ~Profile();
+
+    void add(int phase, uint64_t ticks);
+    uint64_t calls(int phase) const;
+    double seconds(int phase) const;
+    static const char* name(int phase);
+    static bool enabled(); // FALSE if compiled with 'MINISAT_NO_PROFILE'.
+
+    bool openHw(); // Start counting hardware events. Returns FALSE if they are not available.
+    bool hwEnabled() const;
+    uint64_t events(int phase, int event) const; // The events counted during a phase.
+    bool totalEvents(uint64_t* out) const;       // The events counted since 'openHw()'.
+
+   protected:
+    uint64_t phase_calls[nphases];
+    uint64_t phase_ticks[nphases];
+    uint64_t start_ticks;
+    double start_time;
+
+    HwCounters* hw;
+    uint64_t phase_events[nphases][HwCounters::nevents];
+
+    friend class ProfTimer;
+};
+
+// Adds the ticks between construction and destruction to a phase:
+class ProfTimer
+{
+    Profile& prof;
+    int phase;
+    uint64_t start;
+    bool hw_read;
+    uint64_t hw_start[HwCounters::nevents];
+
+   public:
+    ProfTimer(Profile& p, int ph)
+        : prof(p), phase(ph), hw_read(p.hw != NULL && p.hw->read(hw_start))
+    {
+        start = cpuTicks();
+    }
+    ~ProfTimer()
+    {
+        prof.add(phase, cpuTicks() - start);
+        uint64_t hw_end[HwCounters::nevents];
+        if (hw_read && prof.hw->read(hw_end))
+            for (int i = 0; i < HwCounters::nevents; i++)
+                prof.phase_events[phase][i] += hw_end[i] - hw_start[i];
+    }
+};
+
+#ifdef MINISAT_NO_PROFILE
+#define MINISAT_PROFILE(prof, phase)
+#else
+#define MINISAT_PROFILE(prof, phase) \
+    Minisat::ProfTimer prof_timer_(prof, Minisat::Profile::phase)
+#endif
+
+//=================================================================================================
+// Implementation of inline methods:
+
+inline Profile::Profile() : start_ticks(cpuTicks()), start_time(realTime()), hw(NULL)
+{
+    for (int i = 0; i < nphases; i++) {
+        phase_calls[i] = phase_ticks[i] = 0;
+        for (int j = 0; j < HwCounters::nevents; j++)
+            phase_events[i][j] = 0;
+    }
+}
+
+inline Profile::~Profile()
+{
+    delete hw;
+}
+
+inline void Profile::add(int phase, uint64_t ticks)
+{
+    phase_calls[phase]++;
+    phase_ticks[phase] += ticks;
+}
+inline uint64_t Profile::calls(int phase) const
+{
+    return phase_calls[phase];
+}
+
+inline double Profile::seconds(int phase) const
+{
+    double elapsed = realTime() - start_time;
+    uint64_t ticks = cpuTicks() - start_ticks;
+    return ticks == 0 ? 0 : phase_ticks[phase] * (elapsed / ticks);
+}
+
+inline const char* Profile::name(int phase)
+{
+    static const char* names[nphases] = {
+        "propagate", "analyze", "minimize", "reduce", "simplify", "gc",      "probe", "vivify",
+        "walk",      "eliminate", "subsume", "asymm", "elim_var", "blocked", "bva",   "xors"};
+    return names[phase];
+}
+
+inline bool Profile::openHw()
+{
+    if (hw == NULL)
+        hw = new HwCounters();
+    if (!hw->open()) {
+        delete hw;
+        hw = NULL;
+    }
+    return hw != NULL;
+}
+inline bool Profile::hwEnabled() const
+{
+    return hw != NULL;
+}
+inline uint64_t Profile::events(int phase, int event) const
+{
+    return phase_events[phase][event];
+}
+inline bool Profile::totalEvents(uint64_t* out) const
+{
+    return hw != NULL && hw->read(out);
+}
+
+inline bool Profile::enabled()
+{
+#ifdef MINISAT_NO_PROFILE
+    return false;
+#else
+    return true;
+#endif
+}
+
+//=================================================================================================
+} // namespace Minisat
+
+static inline uint64_t Minisat::cpuTicks(void)
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+#endif
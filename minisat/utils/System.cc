@@ -186,3 +186,12 @@ void Minisat::sigTerm(void handler(int))
     signal(SIGXCPU, handler);
 #endif
 }
+
+void Minisat::sigStats(void handler(int))
+{
+#ifdef SIGUSR1
+    signal(SIGUSR1, handler);
+#else
+    (void)handler;
+#endif
+}
@@ -31,7 +31,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 namespace Minisat {
 
-static inline double cpuTime(void); // CPU-time in seconds.
+static inline double cpuTime(void);  // CPU-time in seconds.
+static inline double realTime(void); // Wall-clock time in seconds (since some arbitrary point).
 
 extern double memUsed(); // Memory in mega bytes (returns 0 for unsupported architectures).
 extern double memUsedPeak(
@@ -48,6 +49,8 @@ extern void limitTime(uint32_t max_cpu_time); // Set a limit on maximum CPU time
                                               // semantics varies depending on architecture.
 
 extern void sigTerm(void handler(int)); // Set up handling of available termination signals.
+extern void sigStats(void handler(int)); // Set up handling of the signal asking for statistics
+                                         // ('SIGUSR1', where available).
 
 } // namespace Minisat
 
@@ -62,6 +65,11 @@ static inline double Minisat::cpuTime(void)
     return (double)clock() / CLOCKS_PER_SEC;
 }
 
+static inline double Minisat::realTime(void)
+{
+    return (double)time(NULL);
+}
+
 #else
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -74,6 +82,13 @@ static inline double Minisat::cpuTime(void)
     return (double)ru.ru_utime.tv_sec + (double)ru.ru_utime.tv_usec / 1000000;
 }
 
+static inline double Minisat::realTime(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+}
+
 #endif
 
 #endif